@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+
+#include <agp/algo/coverage_reduction.h>
+#include <agp/algo/couto_algorithm.h>
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/partition.h>
+#include <agp/arrangement/utils.h>
+#include <agp/arrangement/visibility.h>
+#include <agp/generators/polygon_generators.h>
+#include <agp/initial_placements.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// Number of allocations made through operator new so far.
+static std::atomic<std::size_t> allocations{0};
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+/// Reports allocations made since before as an average per iteration.
+void report_allocations(benchmark::State &state, std::size_t before) {
+    state.counters["allocations"] = benchmark::Counter(
+        allocations.load() - before, benchmark::Counter::kAvgIterations);
+}
+
+enum polygon_family {
+    random_family,
+    spiral_family,
+    orthogonal_family,
+    von_koch_family
+};
+
+/// Polygon of a given family with about n vertices.
+std::vector<Kernel::Point_2> benchmark_polygon(polygon_family family,
+                                               std::size_t n) {
+    switch (family) {
+    case random_family:
+        return random_polygon(n);
+    case spiral_family:
+        return spiral_polygon(n);
+    case orthogonal_family:
+        return orthogonal_polygon(n);
+    case von_koch_family: {
+        unsigned level = 0;
+        for (std::size_t size = 4; size * 5 <= n; size *= 5)
+            ++level;
+        return von_koch_polygon(level);
+    }
+    }
+    return {};
+}
+
+/// Runs a benchmark for every polygon family and sizes 16, 64, 256, 1024.
+void polygon_arguments(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"family", "n"});
+    for (int family : {random_family, spiral_family, orthogonal_family,
+                       von_koch_family})
+        for (int n = 16; n <= 1024; n *= 4)
+            b->Args({family, n});
+    b->Unit(benchmark::kMillisecond);
+}
+
+/// Runs a benchmark for orthogonal polygons of sizes 16, 64, 256, 1024.
+void orthogonal_arguments(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"family", "n"});
+    for (int n = 16; n <= 1024; n *= 4)
+        b->Args({orthogonal_family, n});
+    b->Unit(benchmark::kMillisecond);
+}
+
+std::vector<Kernel::Point_2> state_polygon(benchmark::State &state) {
+    auto points = benchmark_polygon(
+        static_cast<polygon_family>(state.range(0)), state.range(1));
+    state.counters["vertices"] = points.size();
+    return points;
+}
+
+void BM_create_arrangement(benchmark::State &state) {
+    auto points = state_polygon(state);
+    std::size_t before = allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(create_arrangement<Arrangement_2>(points));
+    report_allocations(state, before);
+}
+BENCHMARK(BM_create_arrangement)->Apply(polygon_arguments);
+
+void BM_point_visible(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto region = vertex_visibility_region(polygon, points[0]);
+    for (auto _ : state)
+        for (const auto &p : points)
+            benchmark::DoNotOptimize(point_visible(region, p));
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_point_visible)->Apply(polygon_arguments);
+
+void BM_general_point_visibility_region(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto inner = arr_discretization(polygon).front();
+    std::size_t before = allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            general_point_visibility_region(polygon, inner));
+    report_allocations(state, before);
+}
+BENCHMARK(BM_general_point_visibility_region)->Apply(polygon_arguments);
+
+void BM_all_visibility_regions(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    std::size_t before = allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(all_visibility_regions(polygon, points));
+    state.SetItemsProcessed(state.iterations() * points.size());
+    report_allocations(state, before);
+}
+BENCHMARK(BM_all_visibility_regions)->Apply(polygon_arguments);
+
+void BM_overlay_arrangements(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    std::vector<region_handle> regions;
+    for (std::size_t i = 0; i < points.size() && regions.size() < 16; i += 2)
+        regions.push_back(visibility_region_handle(polygon, points[i]));
+    std::size_t before = allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(overlay_arrangements(polygon, regions));
+    report_allocations(state, before);
+}
+BENCHMARK(BM_overlay_arrangements)->Apply(polygon_arguments);
+
+void BM_every_second(benchmark::State &state) {
+    auto points = state_polygon(state);
+    std::size_t before = allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(every_second(points));
+    report_allocations(state, before);
+}
+BENCHMARK(BM_every_second)->Apply(polygon_arguments);
+
+void BM_triangulate(benchmark::State &state) {
+    auto points = state_polygon(state);
+    std::size_t before = allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(triangulate<Arrangement_2>(points));
+    report_allocations(state, before);
+}
+BENCHMARK(BM_triangulate)->Apply(polygon_arguments);
+
+void BM_arr_discretization(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(arr_discretization(polygon));
+}
+BENCHMARK(BM_arr_discretization)->Apply(polygon_arguments);
+
+void BM_uncovered_regions(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_polygon(points);
+    auto visibility_polygons = arrangements_to_polygons(all_visibility_regions(
+        create_arrangement<Arrangement_2>(points), points));
+    std::vector<int> guards;
+    for (std::size_t i = 0; i < points.size(); i += 4)
+        guards.push_back(i);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            uncovered_regions(polygon, visibility_polygons, guards));
+}
+BENCHMARK(BM_uncovered_regions)->Apply(polygon_arguments);
+
+void BM_orthogonal_cells(benchmark::State &state) {
+    auto points = state_polygon(state);
+    state.counters["grid_cells"] = grid_cell_bound(points);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(orthogonal_cells(points));
+}
+BENCHMARK(BM_orthogonal_cells)->Apply(orthogonal_arguments);
+
+/// Same guards as BM_uncovered_regions, so that Couto's algorithm can compare
+/// the two coverage checks of an orthogonal gallery.
+void BM_cells_seen(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto regions = all_visibility_regions(
+        create_arrangement<Arrangement_2>(points), points);
+    auto cells = orthogonal_cells(points);
+    std::vector<int> guards;
+    for (std::size_t i = 0; i < points.size(); i += 4)
+        guards.push_back(i);
+    state.counters["cells"] = cells.size();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cells_seen(cells, regions, guards));
+}
+BENCHMARK(BM_cells_seen)->Apply(orthogonal_arguments);
+
+/// The first matrix reduced by Couto's algorithm, the time per compared bit
+/// sets the work limit of reduce_coverage.
+void BM_reduce_coverage(benchmark::State &state) {
+    auto points = state_polygon(state);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto regions = all_visibility_regions(polygon, points);
+    coverage_matrix coverage;
+    for (const auto &w : arr_discretization(polygon)) {
+        boost::dynamic_bitset<> row(regions.size());
+        for (std::size_t j = 0; j < regions.size(); ++j)
+            row[j] = point_visible(regions[j], w);
+        coverage.push_back(std::move(row));
+    }
+    double w = coverage.size(), g = points.size();
+    state.counters["witnesses"] = w;
+    state.counters["round_bits"] = (w + g) * w * g;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(reduce_coverage(coverage, points.size()));
+}
+BENCHMARK(BM_reduce_coverage)->Apply(polygon_arguments);
+
+BENCHMARK_MAIN();
@@ -9,7 +9,9 @@
  *
  *  The algorithm tackles the point art gallery problem. It tries to find upper
  * and lower bounds of the number of guards until their convergence using linear
- * programming.
+ * programming. Once no new guard improves the dual LP, the value of its
+ * solution, scaled to be feasible for every point of the polygon as a guard,
+ * is a lower bound.
  */
 
 #ifndef AGP_BAUMGARTNER_ALGORITHM_H
@@ -18,6 +20,8 @@
 #include <CGAL/Arr_default_overlay_traits.h>
 #include <CGAL/Arr_overlay_2.h>
 #include <CGAL/centroid.h>
+#include <agp/algo/progress.h>
+#include <agp/arrangement/compaction.h>
 #include <agp/arrangement/utils.h>
 #include <agp/arrangement/visibility.h>
 #include <agp/cplex/cplex.h>
@@ -33,21 +37,60 @@ using vec_t = std::vector<Kernel::Point_2>;
  * std::function<wg_placement(const vec_t &)> initial_placement_method) \brief
  * Potential guards set G and witnesses set W are chosen. Problem relaxation
  * AGR(G, W) is solved using linear programing to obtain an optimal solution
- * from the set G, such that all points from W are guarded. The approach is
- * repeated until new witnesses or new potential guards are found. Such solution
- * solves general AGP, where guards can be placed inside the polygon.
+ * from the set G, such that all points from W are guarded. The relaxation is
+ * built from the coverage matrix reduced by \ref reduce_coverage. The approach
+ * is repeated until new witnesses or new potential guards are found. Such
+ * solution solves general AGP, where guards can be placed inside the polygon.
  * @param vertices - vector of vertices representing a gallery
  * @param initial_placement_method - method that chooses potential guards and
  * witnesses
  * @param sec - number of seconds after which the algorithm should be halted
+ * @param compaction_interval - number of iterations between passes that force
+ * exact values of stored guards, witnesses and their visibility regions (see
+ * \ref compaction.h), 0 disables compaction
+ * @param stats - if not null, filled with a summary of compaction passes
+ * @param guard_regions - if not null, filled with visibility regions of the
+ * returned guards, in the same order
+ * @param progress - if not null, called after each iteration with the bounds,
+ * the best solution found so far and the size of the LP models, returning
+ * false stops the algorithm
  * @return vector of guards or an empty vector if no guards were found within
- * given time
+ * given time or before the algorithm was stopped
  */
 
 vec_t baumgartner_algorithm(
     const vec_t &vertices,
     std::function<wg_placement(const vec_t &)> initial_placement_method,
-    int sec);
+    int sec, unsigned compaction_interval = 0,
+    compaction_stats *stats = nullptr,
+    std::vector<Arrangement_2> *guard_regions = nullptr,
+    const progress_callback &progress = nullptr);
+
+/*! \fn vec_t baumgartner_algorithm(IloEnv &env, const vec_t &vertices,
+ * std::function<wg_placement(const vec_t &)> initial_placement_method, int
+ * sec) \brief Same as \ref baumgartner_algorithm, but builds the LP models in
+ * a given CPLEX environment. All CPLEX objects created by the method are
+ * released before it returns, so one environment can be reused to solve many
+ * galleries.
+ * @param env - CPLEX environment
+ * @param vertices - vector of vertices representing a gallery
+ * @param initial_placement_method - method that chooses potential guards and
+ * witnesses
+ * @param sec - number of seconds after which the algorithm should be halted
+ * @param compaction_interval - see \ref baumgartner_algorithm
+ * @param stats - see \ref baumgartner_algorithm
+ * @param guard_regions - see \ref baumgartner_algorithm
+ * @param progress - see \ref baumgartner_algorithm
+ * @return vector of guards or an empty vector if no guards were found within
+ * given time or before the algorithm was stopped
+ */
+vec_t baumgartner_algorithm(
+    IloEnv &env, const vec_t &vertices,
+    std::function<wg_placement(const vec_t &)> initial_placement_method,
+    int sec, unsigned compaction_interval = 0,
+    compaction_stats *stats = nullptr,
+    std::vector<Arrangement_2> *guard_regions = nullptr,
+    const progress_callback &progress = nullptr);
 
 #endif // AGP_BAUMGARTNER_ALGORITHM_H
 /** @} */
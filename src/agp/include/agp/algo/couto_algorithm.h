@@ -14,6 +14,8 @@
 #include <CGAL/Boolean_set_operations_2.h>
 #include <CGAL/Kernel/global_functions.h>
 #include <CGAL/centroid.h>
+#include <agp/algo/progress.h>
+#include <agp/arrangement/compaction.h>
 #include <agp/arrangement/partition.h>
 #include <agp/arrangement/utils.h>
 #include <agp/arrangement/visibility.h>
@@ -34,16 +36,79 @@ using vec_t = std::vector<Kernel::Point_2>;
  *  Each time an uncovered region is found, a point representing that region is
  * added to the discretization and the IP model is solved again. The method uses
  * Triangular_expansion_visibility_2 class to compute visibility regions for all
- * vertices. The IP model is solved by the CPLEX package. The method provides an
+ * vertices. The IP model is built from the coverage matrix reduced by \ref
+ * reduce_coverage and solved by the CPLEX package. The method provides an
  * optimal solution for the vertex AGP.
  * @param vertices - vector of vertices representing a gallery
  * @param discretization_method - method used to get the initial discretization
  * of the polygon
- * @return vector of guards
+ * @param compaction_interval - number of iterations between passes that force
+ * exact values of the discretization and visibility regions (see \ref
+ * compaction.h), 0 disables compaction
+ * @param stats - if not null, filled with a summary of compaction passes
+ * @param guard_regions - if not null, filled with visibility regions of the
+ * returned guards, in the same order
+ * @param progress - if not null, called after each iteration with the
+ * optimum of the current IP model as the lower bound, returning false stops
+ * the algorithm
+ * @param mip_start - vertices given to CPLEX as the starting solution of each
+ * IP, e.g. guards of a simplified gallery (see multi_resolution.h)
+ * @param cutoff - if not null, called before each IP solve for the size of a
+ * solution known from elsewhere, 0 if there is none. CPLEX then discards
+ * solutions that aren't smaller, and the algorithm stops once the IP has
+ * none, since it cannot improve the known solution.
+ * @return vector of guards, or an empty vector if the algorithm was stopped
+ * before the guards covered the polygon
  */
 vec_t couto_algorithm(
     const vec_t &vertices,
-    const std::function<vec_t(const vec_t &)> &discretization_method);
+    const std::function<vec_t(const vec_t &)> &discretization_method,
+    unsigned compaction_interval = 0, compaction_stats *stats = nullptr,
+    std::vector<Arrangement_2> *guard_regions = nullptr,
+    const progress_callback &progress = nullptr,
+    const vec_t &mip_start = {},
+    const std::function<unsigned long()> &cutoff = nullptr);
+
+/*! \fn vec_t couto_algorithm(IloEnv &env, const vec_t &vertices,
+ * std::function<vec_t(const vec_t &)> discretization_method) \brief Same as
+ * \ref couto_algorithm, but builds the IP model in a given CPLEX environment.
+ * All CPLEX objects created by the method are released before it returns, so
+ * one environment can be reused to solve many galleries.
+ * @param env - CPLEX environment
+ * @param vertices - vector of vertices representing a gallery
+ * @param discretization_method - method used to get the initial discretization
+ * of the polygon
+ * @param compaction_interval - see \ref couto_algorithm
+ * @param stats - see \ref couto_algorithm
+ * @param guard_regions - see \ref couto_algorithm
+ * @param progress - see \ref couto_algorithm
+ * @param mip_start - see \ref couto_algorithm
+ * @param cutoff - see \ref couto_algorithm
+ * @return vector of guards, or an empty vector if the algorithm was stopped
+ * before the guards covered the polygon
+ */
+vec_t couto_algorithm(
+    IloEnv &env, const vec_t &vertices,
+    const std::function<vec_t(const vec_t &)> &discretization_method,
+    unsigned compaction_interval = 0, compaction_stats *stats = nullptr,
+    std::vector<Arrangement_2> *guard_regions = nullptr,
+    const progress_callback &progress = nullptr,
+    const vec_t &mip_start = {},
+    const std::function<unsigned long()> &cutoff = nullptr);
+
+/*! \fn std::vector<Polygon_with_holes_2> uncovered_regions(const Polygon_2
+ * &polygon, const std::vector<Polygon_2> &visibility_polygons, const
+ * std::vector<int> &guards) \brief Computes parts of the polygon that are not
+ * seen by the chosen guards.
+ * @param polygon - gallery
+ * @param visibility_polygons - visibility polygons of all candidate guards
+ * @param guards - indices of the chosen guards in visibility_polygons
+ * @return regions of the polygon not covered by the guards
+ */
+std::vector<Polygon_with_holes_2>
+uncovered_regions(const Polygon_2 &polygon,
+                  const std::vector<Polygon_2> &visibility_polygons,
+                  const std::vector<int> &guards);
 
 #endif // AGP_EXACT_ALGORITHM_H
 /** @} */
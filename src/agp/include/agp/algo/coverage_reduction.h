@@ -0,0 +1,97 @@
+/*! \file coverage_reduction.h
+ * \brief Reduction of the set cover instances solved by the exact algorithms.
+ *
+ * \ref couto_algorithm and \ref baumgartner_algorithm pick guards covering a
+ * set of witnesses. The coverage matrix of such an instance has a row for each
+ * witness and a column for each candidate guard. Before the model is built,
+ * the matrix is reduced with the usual rules:
+ * - a witness seen by a superset of the guards seeing another witness is
+ *   covered whenever the other one is, so its row is dropped,
+ * - a guard seeing a subset of the witnesses seen by another guard can be
+ *   replaced by it in any solution, so its column is dropped,
+ * - a guard that is the only one seeing some witness is in every solution, it
+ *   is fixed and the witnesses it sees are dropped.
+ *
+ * The rules keep the optimum of both the integer and the linear relaxation,
+ * and solutions of the reduced instance are mapped back to the original one.
+ */
+#ifndef AGP_ALGO_COVERAGE_REDUCTION_H
+#define AGP_ALGO_COVERAGE_REDUCTION_H
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/*! \typedef coverage_matrix
+ * Rows of a coverage matrix, bit j of row i is set if guard j sees witness i.
+ */
+using coverage_matrix = std::vector<boost::dynamic_bitset<>>;
+
+/*! \struct coverage_reduction
+ * A reduced coverage matrix with the indices needed to map its solutions back.
+ */
+struct coverage_reduction {
+    std::size_t witness_count = 0; /*!< witnesses of the original matrix */
+    std::size_t guard_count = 0;   /*!< guards of the original matrix */
+    std::vector<std::size_t> witnesses; /*!< original indices of kept rows */
+    std::vector<std::size_t> guards; /*!< original indices of kept columns */
+    std::vector<std::size_t> forced; /*!< guards fixed in every solution */
+    std::vector<std::size_t>
+        forcing; /*!< for each forced guard, a witness only it sees */
+    coverage_matrix matrix; /*!< kept rows restricted to the kept columns */
+};
+
+/*! \fn coverage_reduction reduce_coverage(const coverage_matrix &matrix,
+ * std::size_t guards, double work_limit) \brief Applies the reduction rules
+ * until none of them changes the matrix. Witnesses seen by no guard are kept,
+ * so an infeasible instance stays infeasible.
+ *
+ * A round of the dominance rules on w witnesses and g guards compares
+ * (w + g) * w * g bits. The rounds stop once they would exceed the work limit,
+ * then only the forced guards are fixed. The default limit takes about a
+ * quarter of a second and is reached by matrices with a few thousand rows and
+ * columns, whose IP takes far longer to solve.
+ * @param matrix - rows of the coverage matrix, one for each witness
+ * @param guards - number of columns of the matrix
+ * @param work_limit - bits the dominance rules may compare in total
+ * @return the reduced matrix
+ */
+coverage_reduction reduce_coverage(const coverage_matrix &matrix,
+                                   std::size_t guards,
+                                   double work_limit = 1e11);
+
+/*! \fn std::vector<int> expand_guards(const coverage_reduction &reduction,
+ * const std::vector<int> &chosen) \brief Maps chosen guards of the reduced
+ * matrix back to the original one and adds the forced guards.
+ * @param reduction - reduction that produced the matrix
+ * @param chosen - indices of guards in the reduced matrix
+ * @return indices of guards in the original matrix
+ */
+std::vector<int> expand_guards(const coverage_reduction &reduction,
+                               const std::vector<int> &chosen);
+
+/*! \fn std::vector<double> expand_guard_values(const coverage_reduction
+ * &reduction, const std::vector<double> &values) \brief Maps a solution of the
+ * linear relaxation of the reduced matrix back to all the guards. Forced guards
+ * get 1 and dropped guards get 0.
+ * @param reduction - reduction that produced the matrix
+ * @param values - value of each guard of the reduced matrix
+ * @return value of each guard of the original matrix
+ */
+std::vector<double> expand_guard_values(const coverage_reduction &reduction,
+                                        const std::vector<double> &values);
+
+/*! \fn std::vector<double> expand_witness_values(const coverage_reduction
+ * &reduction, const std::vector<double> &values) \brief Maps a solution of the
+ * dual of the linear relaxation back to all the witnesses. The witness that
+ * forced a guard gets 1 and the other dropped witnesses get 0, which keeps
+ * the dual feasible and equal in value to the primal.
+ * @param reduction - reduction that produced the matrix
+ * @param values - value of each witness of the reduced matrix
+ * @return value of each witness of the original matrix
+ */
+std::vector<double> expand_witness_values(const coverage_reduction &reduction,
+                                          const std::vector<double> &values);
+
+#endif // AGP_ALGO_COVERAGE_REDUCTION_H
@@ -16,6 +16,7 @@
 #include <agp/plot/agp_plot.h>
 
 #include <algorithm>
+#include <functional>
 #include <ostream>
 #include <set>
 
@@ -23,10 +24,16 @@
  * std::vector<Kernel::Point_2> &vertices) \brief An approximation algorithm
  * that reduces the AGP to the set cover problem.
  * @param vertices - vector of vertices representing a gallery
- * @return vector of guards
+ * @param guard_regions - if not null, filled with visibility regions of the
+ * returned guards, in the same order
+ * @param cancelled - if not null, checked between the phases of the algorithm
+ * and for every vertex while its fans are built, returning true stops it
+ * @return vector of guards, or an empty vector if the algorithm was cancelled
  */
 std::vector<Kernel::Point_2>
-ghosh_algorithm(const std::vector<Kernel::Point_2> &vertices);
+ghosh_algorithm(const std::vector<Kernel::Point_2> &vertices,
+                std::vector<Arrangement_2> *guard_regions = nullptr,
+                const std::function<bool()> &cancelled = nullptr);
 
 #endif // AGP_GHOSH_ALGORITHM_H
 
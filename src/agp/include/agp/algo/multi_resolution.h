@@ -0,0 +1,58 @@
+/*!
+ *  @defgroup multi_resolution
+ *  @{
+ *  \file multi_resolution.h
+ *  \brief Solves a simplified gallery first and refines its solution on the
+ * full gallery. \page multi_resolution_algo Multi-resolution \brief Solves a
+ * simplified gallery first and refines its solution on the full gallery.
+ *
+ * The exact algorithms pay for every edge of a gallery, while the guards of a
+ * detailed outline usually stand close to the guards of its coarse shape.
+ * \ref multi_resolution_algorithm simplifies the outline with \ref
+ * simplify_polygon, solves the coarse gallery and passes its guards to the
+ * solve of the full gallery, as the starting solution of Couto's IPs or as
+ * additional candidates of Baumgartner's algorithm.
+ */
+#ifndef AGP_MULTI_RESOLUTION_H
+#define AGP_MULTI_RESOLUTION_H
+
+#include <agp/algo/progress.h>
+#include <agp/arrangement/utils.h>
+
+#include <vector>
+
+/*! \struct multi_resolution_options
+ * Settings of \ref multi_resolution_algorithm.
+ */
+struct multi_resolution_options {
+    Kernel::FT tolerance = 0;   /*!< see \ref simplify_polygon */
+    bool vertex_guards = true;  /*!< finish with Couto's algorithm, otherwise
+                                 * with Baumgartner's */
+    int sec = 300;              /*!< time limit of both Baumgartner's solves,
+                                 * the full gallery gets what the coarse one
+                                 * left */
+    progress_callback progress; /*!< if not null, called after iterations of
+                                 * both solves, see
+                                 * \ref multi_resolution_algorithm */
+};
+
+/*! \fn std::vector<Kernel::Point_2> multi_resolution_algorithm(const
+ * std::vector<Kernel::Point_2> &vertices, const multi_resolution_options
+ * &options) \brief Solves the gallery simplified within the tolerance, then
+ * the full gallery seeded with the guards of the simplified one. A gallery
+ * without removable vertices is solved directly. The progress callback sees
+ * one run: iterations and time count from the start, and during the coarse
+ * solve the bounds are 0 and \ref guard_upper_bound of the full gallery, with
+ * no incumbent. Stopping the coarse solve also stops the full one after its
+ * first iteration.
+ * @param vertices - vector of vertices representing a gallery
+ * @param options - settings of the solve
+ * @return guards of the full gallery, see \ref couto_algorithm and \ref
+ * baumgartner_algorithm
+ */
+std::vector<Kernel::Point_2>
+multi_resolution_algorithm(const std::vector<Kernel::Point_2> &vertices,
+                           const multi_resolution_options &options = {});
+
+#endif // AGP_MULTI_RESOLUTION_H
+/** @} */
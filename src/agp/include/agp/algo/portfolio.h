@@ -0,0 +1,66 @@
+/*!
+ *  @defgroup portfolio
+ *  @{
+ *  \file portfolio.h
+ *  \brief A portfolio solver running Fisk's, Ghosh's, Couto's and
+ * Baumgartner's algorithms at the same time. \page portfolio_algo Portfolio
+ *  \brief A portfolio solver running all the algorithms at the same time and
+ * sharing their bounds.
+ */
+#ifndef AGP_PORTFOLIO_H
+#define AGP_PORTFOLIO_H
+
+#include <agp/algo/progress.h>
+#include <agp/arrangement/visibility.h>
+
+#include <string>
+#include <vector>
+
+/*! \struct portfolio_options
+ * Settings of \ref portfolio_algorithm.
+ */
+struct portfolio_options {
+    bool vertex_guards = false; /*!< solve the AGP with guards restricted to
+                                 * vertices of the gallery */
+    double time_limit = 0;      /*!< wall time limit in seconds, 0 for none */
+    progress_callback progress; /*!< if not null, called with the shared
+                                 * bounds after each iteration of an exact
+                                 * algorithm, returning false stops the race */
+};
+
+/*! \struct portfolio_result
+ * Best solution found by \ref portfolio_algorithm.
+ */
+struct portfolio_result {
+    std::vector<Kernel::Point_2> guards; /*!< best solution, empty if none */
+    std::string algorithm;     /*!< name of the algorithm that found it */
+    unsigned long lower_bound; /*!< best lower bound on the number of guards */
+    bool optimal;              /*!< whether the solution is proven optimal */
+};
+
+/*! \fn portfolio_result portfolio_algorithm(const
+ * std::vector<Kernel::Point_2> &vertices, const portfolio_options &options)
+ * \brief Races Fisk's, Ghosh's, Couto's and Baumgartner's algorithms on the
+ * shared thread pool. Every solution found becomes an upper bound for the
+ * exact algorithms, which stop once their own lower bound reaches it. The
+ * lower bounds of Baumgartner's algorithm, values of its dual LP solutions,
+ * hold for both kinds of guards, the ones of Couto's algorithm only for
+ * vertex guards. The race stops when the
+ * best solution is proven optimal, in particular when Couto's algorithm
+ * finishes in the vertex guard variant, or when the time limit passes. The
+ * exact algorithms notice it after their current iteration, Ghosh's algorithm
+ * after its current phase, and the function returns once all the algorithms
+ * have stopped. The size of the best solution is passed to CPLEX as a cutoff
+ * of Couto's IPs. A star-shaped gallery is solved without a race by a guard
+ * in its kernel, reported as the "kernel" algorithm.
+ * @param vertices - vector of vertices representing a gallery
+ * @param options - settings of the race
+ * @return best solution with its lower bound
+ */
+portfolio_result
+portfolio_algorithm(const std::vector<Kernel::Point_2> &vertices,
+                    const portfolio_options &options = portfolio_options());
+
+#endif // AGP_PORTFOLIO_H
+
+/** @} */
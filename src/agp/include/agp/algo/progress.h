@@ -0,0 +1,54 @@
+/*! \file progress.h
+ * \brief Progress reporting of the iterative algorithms.
+ *
+ * \ref baumgartner_algorithm and \ref couto_algorithm call a \ref
+ * progress_callback after each of their iterations. The callback receives the
+ * current bounds on the number of guards and the best solution found so far,
+ * and can stop the algorithm, which then returns that solution.
+ * \ref memory_budget uses the callback to bound the memory of a run.
+ */
+#ifndef AGP_ALGO_PROGRESS_H
+#define AGP_ALGO_PROGRESS_H
+
+#include <agp/arrangement/visibility.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/*! \struct iteration_progress
+ * State of an iterative algorithm after one of its iterations.
+ */
+struct iteration_progress {
+    unsigned long iteration;   /*!< number of finished iterations */
+    double elapsed;            /*!< wall time since the start in seconds */
+    unsigned long lower_bound; /*!< proven lower bound on the number of
+                                * guards, 0 until the algorithm proves one */
+    unsigned long upper_bound; /*!< upper bound on the number of guards */
+    std::vector<Kernel::Point_2>
+        incumbent;         /*!< best feasible solution, empty if none */
+    std::size_t guards;    /*!< candidate guards in the model */
+    std::size_t witnesses; /*!< witnesses in the model */
+};
+
+/*! \typedef progress_callback
+ * Function called after each iteration, returning false stops the algorithm.
+ */
+using progress_callback = std::function<bool(const iteration_progress &)>;
+
+/*! \fn progress_callback memory_budget(std::size_t bytes, progress_callback
+ * next, bool *exceeded) \brief Creates a callback that stops the algorithm
+ * once the resident memory of the process exceeds a budget. The memory is
+ * checked after each iteration, so the algorithm can still return its best
+ * solution.
+ * @param bytes - memory budget in bytes
+ * @param next - callback called while the budget is not exceeded, may be null
+ * @param exceeded - if not null, set to true when the budget stops the
+ * algorithm
+ * @return callback to pass to the algorithm
+ */
+progress_callback memory_budget(std::size_t bytes,
+                                progress_callback next = nullptr,
+                                bool *exceeded = nullptr);
+
+#endif // AGP_ALGO_PROGRESS_H
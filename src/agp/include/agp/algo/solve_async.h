@@ -0,0 +1,115 @@
+/*!
+ *  @defgroup solve_async
+ *  @{
+ *  \file solve_async.h
+ *  \brief Asynchronous interface to all the algorithms. \page solve_async_page
+ * Asynchronous solving \brief Asynchronous interface to all the algorithms.
+ *
+ * \ref solve_async queues a gallery on the shared thread pool (see
+ * thread_pool.h) and returns at once, so many galleries can be in flight
+ * without a thread for each of them. The returned \ref solve_handle gives
+ * the progress and the best solution of a running job, cancels it and waits
+ * for its result.
+ */
+#ifndef AGP_SOLVE_ASYNC_H
+#define AGP_SOLVE_ASYNC_H
+
+#include <agp/algo/progress.h>
+#include <agp/arrangement/visibility.h>
+
+#include <future>
+#include <memory>
+#include <vector>
+
+/*! \enum agp_algorithm
+ * Algorithms available in \ref solve_async.
+ */
+enum class agp_algorithm { fisk, ghosh, couto, baumgartner, portfolio };
+
+/*! \struct solve_options
+ * Settings of \ref solve_async.
+ */
+struct solve_options {
+    unsigned compaction_interval = 0; /*!< see \ref compaction.h */
+    double time_limit = 0; /*!< wall time limit in seconds, 0 for none */
+    bool vertex_guards = false; /*!< see \ref portfolio_options */
+    progress_callback progress; /*!< if not null, called on the pool after
+                                 * each iteration, returning false stops the
+                                 * job */
+};
+
+/*! \class solve_handle
+ * \brief Handle of a job started by \ref solve_async. The job keeps running
+ * when the handle is destroyed. A default-constructed handle has no job, see
+ * \ref valid.
+ *
+ * Fisk's and Ghosh's algorithms don't iterate, so they report no progress
+ * and can only be cancelled before they start. Couto's, Baumgartner's and
+ * the portfolio algorithm stop after their current iteration.
+ */
+class solve_handle {
+  public:
+    /// @return whether the handle refers to a job whose result wasn't taken
+    bool valid() const;
+
+    /// @return whether the result is available, false for an invalid handle
+    bool ready() const;
+
+    /*! \fn std::vector<Kernel::Point_2> get()
+     * \brief Waits for the job and returns its guards. A cancelled or timed
+     * out job returns what the algorithm returns when it is stopped, see
+     * \ref progress.h. Can be called once, the handle is invalid afterwards.
+     * @return guards, rethrows exceptions of the algorithm
+     * @throw std::logic_error if the handle is not valid
+     */
+    std::vector<Kernel::Point_2> get();
+
+    /// Asks the job to stop at the next iteration, does nothing for a handle
+    /// without a job.
+    void cancel();
+
+    /// @return whether \ref cancel was called
+    bool cancelled() const;
+
+    /*! \fn iteration_progress progress() const
+     * @return state after the last finished iteration, with iteration equal
+     * to 0 before the first one and for a handle without a job
+     */
+    iteration_progress progress() const;
+
+    /*! \fn std::vector<Kernel::Point_2> partial_result() const
+     * \brief Couto's algorithm has no solution covering the gallery before
+     * its last iteration, so for it the result stays empty until the end.
+     * Baumgartner's algorithm and the portfolio report their best solution
+     * after each iteration.
+     * @return best solution found so far, empty if none
+     */
+    std::vector<Kernel::Point_2> partial_result() const;
+
+  private:
+    struct shared_state;
+
+    friend solve_handle solve_async(const std::vector<Kernel::Point_2> &,
+                                    agp_algorithm, const solve_options &);
+
+    std::shared_ptr<shared_state> state_;
+    std::future<std::vector<Kernel::Point_2>> result_;
+};
+
+/*! \fn solve_handle solve_async(const std::vector<Kernel::Point_2> &vertices,
+ * agp_algorithm algorithm, const solve_options &options) \brief Starts
+ * solving a gallery on the shared thread pool. The vertices are copied, so
+ * they can be released or changed once the function returns.
+ * @param vertices - vector of vertices representing a gallery
+ * @param algorithm - algorithm to run, with the initial placements used by
+ * the client
+ * @param options - settings of the job
+ * @return handle of the job
+ */
+solve_handle solve_async(const std::vector<Kernel::Point_2> &vertices,
+                         agp_algorithm algorithm,
+                         const solve_options &options = solve_options());
+
+#endif // AGP_SOLVE_ASYNC_H
+
+/** @} */
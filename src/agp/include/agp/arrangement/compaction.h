@@ -0,0 +1,95 @@
+/*! \file compaction.h
+ * \brief Provides functions that flatten lazily constructed objects.
+ *
+ * Objects of the Epeck kernel are lazy - each of them keeps the whole DAG of
+ * constructions it was obtained from until its exact value is needed. Long
+ * living points and arrangements built in later iterations of the algorithms
+ * keep growing those histories. Forcing the exact value of an object replaces
+ * its DAG with a flat exact representation and releases the nodes no other
+ * object refers to.
+ */
+#ifndef AGP_ARRANGEMENT_COMPACTION_H
+#define AGP_ARRANGEMENT_COMPACTION_H
+
+#include <agp/arrangement/utils.h>
+#include <agp/profile/memory.h>
+
+#include <cstddef>
+#include <vector>
+
+/*! \struct compaction_stats
+ * Summary of compaction passes run by an algorithm.
+ */
+struct compaction_stats {
+    unsigned long passes = 0;  /*!< number of passes run */
+    long long freed_bytes = 0; /*!< heap memory released by all passes,
+                                * negative if exact values took more memory
+                                * than the construction histories */
+};
+
+/*! \fn void exactify(const Kernel::Point_2 &point)
+ * \brief Computes the exact value of a point and drops its construction
+ * history.
+ * @param point - lazy point
+ */
+void exactify(const Kernel::Point_2 &point);
+
+/*! \fn void exactify(const std::vector<Kernel::Point_2> &points)
+ * \brief Computes exact values of all the points.
+ * @param points - vector of lazy points
+ */
+void exactify(const std::vector<Kernel::Point_2> &points);
+
+/*! \fn void exactify(const Arrangement_2 &arr)
+ * \brief Computes exact values of all vertices and curves of an arrangement.
+ * @param arr - given arrangement
+ */
+void exactify(const Arrangement_2 &arr);
+
+/*! \fn void exactify(const std::vector<Arrangement_2> &arrangements)
+ * \brief Computes exact values of all vertices and curves of the
+ * arrangements.
+ * @param arrangements - vector of arrangements
+ */
+void exactify(const std::vector<Arrangement_2> &arrangements);
+
+/*! \fn void exactify(const std::vector<region_handle> &regions)
+ * \brief Computes exact values of all vertices and curves of the shared
+ * regions.
+ * @param regions - vector of region handles
+ */
+void exactify(const std::vector<region_handle> &regions);
+
+/*! \fn void exactify(const std::vector<Polygon_2> &polygons)
+ * \brief Computes exact values of vertices of all the polygons.
+ * @param polygons - vector of polygons
+ */
+void exactify(const std::vector<Polygon_2> &polygons);
+
+/*! \fn Kernel::Point_2 detached_copy(const Kernel::Point_2 &point)
+ * \brief Creates a point with the exact value of the given one that shares no
+ * construction history with it. Reference counts of lazy objects are not
+ * thread-safe, so points handed to another thread must be detached copies
+ * made on the owning thread.
+ * @param point - lazy point
+ * @return independent copy of the point
+ */
+Kernel::Point_2 detached_copy(const Kernel::Point_2 &point);
+
+/*! \fn std::vector<Kernel::Point_2> detached_copy(const
+ * std::vector<Kernel::Point_2> &points) \brief Creates detached copies of all
+ * the points.
+ * @param points - vector of lazy points
+ * @return vector of independent copies
+ */
+std::vector<Kernel::Point_2>
+detached_copy(const std::vector<Kernel::Point_2> &points);
+
+/*! \fn void record_compaction(std::size_t heap_before, compaction_stats
+ * *stats) \brief Adds a finished compaction pass to the statistics.
+ * @param heap_before - value of \ref heap_in_use measured before the pass
+ * @param stats - statistics to update, ignored if null
+ */
+void record_compaction(std::size_t heap_before, compaction_stats *stats);
+
+#endif // AGP_ARRANGEMENT_COMPACTION_H
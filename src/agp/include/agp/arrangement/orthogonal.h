@@ -0,0 +1,80 @@
+/*! \file orthogonal.h
+ * \brief Shortcuts for orthogonal galleries, whose edges are all parallel to
+ * the axes.
+ *
+ * The vertical and horizontal lines through the vertices of an orthogonal
+ * polygon split it into rectangular cells with corners at the coordinates of
+ * the vertices, so no rational constructions are needed to describe them. A
+ * guard that sees the four corners of a cell sees the whole cell, as the
+ * polygon is simple and the cell is convex. Orthogonal galleries never need
+ * more than \f$ \lfloor n/4 \rfloor \f$ vertex guards.
+ */
+#ifndef AGP_ARRANGEMENT_ORTHOGONAL_H
+#define AGP_ARRANGEMENT_ORTHOGONAL_H
+
+#include <agp/arrangement/utils.h>
+
+#include <cstddef>
+#include <vector>
+
+/*! \struct grid_cell
+ * A cell of the grid through the vertices of an orthogonal polygon.
+ */
+struct grid_cell {
+    Kernel::Point_2 lower_left;  /*!< corner with the smallest coordinates */
+    Kernel::Point_2 upper_right; /*!< corner with the largest coordinates */
+};
+
+/*! \fn bool is_orthogonal(const std::vector<Kernel::Point_2> &vertices)
+ * \brief Checks whether all the edges of a polygon are axis-parallel.
+ * @param vertices - vertices of the polygon
+ * @return true if the polygon is orthogonal
+ */
+bool is_orthogonal(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn unsigned long guard_upper_bound(const std::vector<Kernel::Point_2>
+ * &vertices) \brief Number of vertex guards that always suffice for the
+ * polygon, \f$ \lfloor n/4 \rfloor \f$ for orthogonal polygons and
+ * \f$ \lfloor n/3 \rfloor \f$ for the others.
+ * @param vertices - vertices of the polygon
+ * @return upper bound on the optimal number of guards
+ */
+unsigned long guard_upper_bound(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::size_t grid_cell_bound(const std::vector<Kernel::Point_2>
+ * &vertices) \brief Counts the cells of the grid through the vertices within
+ * their bounding box in \f$ O(n \log n) \f$ time, an upper bound on the
+ * number of \ref orthogonal_cells. It grows quadratically for galleries like
+ * spirals, whose vertices have few shared coordinates.
+ * @param vertices - vertices of a polygon
+ * @return number of cells of the grid
+ */
+std::size_t grid_cell_bound(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::vector<grid_cell> orthogonal_cells(const
+ * std::vector<Kernel::Point_2> &vertices) \brief Computes the cells of the
+ * grid through the vertices that lie inside the polygon. Each row of the grid
+ * is filtered by a scan over the vertical edges crossing it, in
+ * \f$ O(n^2 \log n) \f$ time overall.
+ * @param vertices - vertices of an orthogonal polygon
+ * @return cells covering the polygon, row by row
+ */
+std::vector<grid_cell>
+orthogonal_cells(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn bool cells_seen(const std::vector<grid_cell> &cells, const
+ * std::vector<Arrangement_2> &visibility_regions, const std::vector<int>
+ * &guards) \brief Checks whether every cell is seen as a whole by one of the
+ * guards. It is a sufficient condition for the guards to cover the polygon,
+ * which avoids computing the uncovered regions with boolean operations.
+ * @param cells - cells of the polygon, see \ref orthogonal_cells
+ * @param visibility_regions - visibility regions of the candidate guards
+ * @param guards - indices of the chosen guards in visibility_regions
+ * @return true if each cell is seen by a single guard, false if the guards
+ * may leave a part of the polygon unseen
+ */
+bool cells_seen(const std::vector<grid_cell> &cells,
+                const std::vector<Arrangement_2> &visibility_regions,
+                const std::vector<int> &guards);
+
+#endif // AGP_ARRANGEMENT_ORTHOGONAL_H
@@ -33,14 +33,82 @@ using Triangulation = CGAL::Triangulation_2<Kernel>;
 void to_convex_components(const std::vector<Kernel::Point_2> &vertices,
                           std::list<Partition_Polygon_2> &output);
 
-/*! \fn std::list<Kernel::Point_2> arr_discretization (const Arrangement_2 &arr)
- *  \brief Discretizes a simple polygon given as an instance of the
- * Arrangement_2 class from CGAL. It divides the polygon into convex components
- * and returns their centroids.
- *  @param arr - simple polygon represented as an Arrangement_2
+/*! \fn void to_convex_components (const std::vector<Kernel::Point_2> &vertices,
+ * arena_list<Partition_Polygon_2> &output) \brief Same as \ref
+ * to_convex_components, but the list takes its nodes from the current arena
+ * (see arena.h).
+ * @param vertices - vector of vertices representing a polygon
+ * @param output - list of convex components of the given polygon
+ */
+void to_convex_components(const std::vector<Kernel::Point_2> &vertices,
+                          arena_list<Partition_Polygon_2> &output);
+
+/*! \fn Kernel::FT simplest_rational (const Kernel::FT &a, const Kernel::FT &b)
+ * \brief Finds the rational number with the smallest denominator that lies in
+ * the open interval \f$ (a, b) \f$. The number is found by expanding both
+ * ends of the interval into continued fractions, so its bit size depends only
+ * on the width of the interval and not on the bit size of its ends.
+ * @param a - lower end of the interval
+ * @param b - upper end of the interval, must be greater than a
+ * @return simplest rational number from the interval
+ */
+Kernel::FT simplest_rational(const Kernel::FT &a, const Kernel::FT &b);
+
+/*! \fn Kernel::Point_2 small_interior_point (const
+ * std::vector<Kernel::Point_2> &convex) \brief Picks a point in the interior of
+ * a convex polygon whose coordinates have small numerators and denominators.
+ * The x-coordinate is the simplest rational from the middle half of the
+ * polygon's x-range and the y-coordinate is the simplest rational from the
+ * middle half of the vertical slice through it. Unlike the centroid, the
+ * result does not inherit the bit size of the polygon's vertices.
+ * @param convex - vertices of a convex polygon with a non-empty interior
+ * @return point lying in the interior of the polygon
+ */
+Kernel::Point_2
+small_interior_point(const std::vector<Kernel::Point_2> &convex);
+
+/*! \fn std::list<Kernel::Point_2> discretize_reflex (const
+ * std::vector<Kernel::Point_2> &vertices) \brief Divides a simple polygon into
+ * convex components and returns a \ref small_interior_point of each of them.
+ * @param vertices - vertices of the polygon in counterclockwise order
+ * @return list of points discretizing the polygon
+ */
+std::list<Kernel::Point_2>
+discretize_reflex(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::vector<Kernel::Segment_2> extension_chords (const
+ * std::vector<Kernel::Point_2> &vertices) \brief Extends both edges at each
+ * reflex vertex into the polygon until they hit its boundary. The chords cut
+ * the polygon into convex faces, at most \f$ O(r^2) \f$ of them for
+ * \f$ r \f$ reflex vertices.
+ * @param vertices - vertices of the polygon in counterclockwise order
+ * @return chords from the reflex vertices to the boundary, a chord joining two
+ * reflex vertices is returned once
+ * @throw std::invalid_argument if an extended edge leaves the polygon, which
+ * happens only for clockwise or self-intersecting input
+ */
+std::vector<Kernel::Segment_2>
+extension_chords(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::list<Kernel::Point_2> arr_discretization (const Arrangement &arr)
+ *  \brief Discretizes the bounded faces of an arrangement with \ref
+ * discretize_reflex.
+ *  @tparam Arrangement - a class of type CGAL::Arrangement_2, e.g. an \ref
+ * Arena_arrangement_2 built for the discretization only
+ *  @param arr - arrangement whose bounded faces are simple polygons
  *  @return list of vertices discretizing the given polygon
  */
-std::list<Kernel::Point_2> arr_discretization(const Arrangement_2 &arr);
+template <typename Arrangement>
+std::list<Kernel::Point_2> arr_discretization(const Arrangement &arr) {
+    std::list<Kernel::Point_2> points;
+    for (auto f = arr.faces_begin(); f != arr.faces_end(); ++f) {
+        if (f->is_unbounded())
+            continue;
+        auto to_add = discretize_reflex(face_vertices(f));
+        points.splice(points.end(), to_add);
+    }
+    return points;
+}
 
 /*! \fn Arrangement triangulate (const std::vector<Kernel::Point_2> &vertices)
  * \brief Triangulates a given polygon using a build-in method from CGAL.
@@ -54,7 +122,7 @@ Arrangement triangulate(const std::vector<Kernel::Point_2> &vertices) {
     std::list<Partition_Polygon_2> partition_polys;
     to_convex_components(vertices, partition_polys);
 
-    std::vector<Arrangement> triangles;
+    std::vector<std::vector<Kernel::Point_2>> corners;
     Triangulation t;
     t.insert(vertices.begin(), vertices.end());
 
@@ -63,13 +131,18 @@ Arrangement triangulate(const std::vector<Kernel::Point_2> &vertices) {
         t.insert(part.vertices_begin(), part.vertices_end());
         for (auto face = t.finite_faces_begin(); face != t.finite_faces_end();
              ++face) {
-            std::vector<Kernel::Point_2> vertices = {face->vertex(0)->point(),
-                                                     face->vertex(1)->point(),
-                                                     face->vertex(2)->point()};
-            triangles.push_back(create_arrangement<Arrangement>(vertices));
+            corners.push_back({face->vertex(0)->point(),
+                               face->vertex(1)->point(),
+                               face->vertex(2)->point()});
         }
     }
 
+    // triangles are built in place, growing a vector of arrangements would
+    // copy them
+    std::vector<Arrangement> triangles(corners.size());
+    for (std::size_t i = 0; i < corners.size(); ++i)
+        insert_polygon(triangles[i], corners[i].begin(), corners[i].end());
+
     return overlay_arrangements<Arrangement>(Arrangement(), triangles);
 }
 
@@ -0,0 +1,36 @@
+/*! \file simplification.h
+ * \brief Simplification of detailed gallery outlines.
+ *
+ * Galleries with many tiny edges, such as von Koch islands or scanned plans,
+ * can first be solved on a coarser outline. A vertex is merged into the edge
+ * joining its neighbours when the edge lies close to all the vertices it
+ * replaces, as long as the outline stays simple. The remaining vertices are
+ * vertices of the original gallery.
+ */
+#ifndef AGP_ARRANGEMENT_SIMPLIFICATION_H
+#define AGP_ARRANGEMENT_SIMPLIFICATION_H
+
+#include <agp/arrangement/utils.h>
+
+#include <vector>
+
+/*! \fn std::vector<Kernel::Point_2> simplify_polygon(const
+ * std::vector<Kernel::Point_2> &vertices, const Kernel::FT &tolerance)
+ * \brief Removes a vertex when the edge joining its neighbours stays within a
+ * distance of all the original vertices it replaces, the removed vertex and
+ * the ones removed before between its neighbours. As in the Douglas-Peucker
+ * algorithm, every original vertex ends within the distance of the simplified
+ * outline. A vertex is removed only if no other vertex lies in the triangle it
+ * forms with its neighbours, so the new edge crosses no other edge and the
+ * polygon stays simple. Removals are repeated until no vertex can be removed,
+ * each check takes \f$ O(n) \f$ time.
+ * @param vertices - vertices of a simple polygon
+ * @param tolerance - largest distance of a removed vertex from the edge
+ * replacing it, 0 removes vertices lying on such an edge only
+ * @return remaining vertices in their original order, at least three
+ */
+std::vector<Kernel::Point_2>
+simplify_polygon(const std::vector<Kernel::Point_2> &vertices,
+                 const Kernel::FT &tolerance);
+
+#endif // AGP_ARRANGEMENT_SIMPLIFICATION_H
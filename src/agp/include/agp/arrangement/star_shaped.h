@@ -0,0 +1,61 @@
+/*! \file star_shaped.h
+ * \brief Kernel of a polygon and a single guard for star-shaped galleries.
+ *
+ * The kernel of a polygon is the set of points that see the whole polygon,
+ * i.e. the intersection of the inner half-planes of all its edges. A gallery
+ * with a non-empty kernel is star-shaped and one guard placed in its kernel
+ * is an optimal solution, so the algorithms check it before building any
+ * visibility regions.
+ */
+#ifndef AGP_ARRANGEMENT_STAR_SHAPED_H
+#define AGP_ARRANGEMENT_STAR_SHAPED_H
+
+#include <agp/arrangement/utils.h>
+
+#include <vector>
+
+/*! \fn std::vector<Kernel::Point_2> polygon_kernel(const
+ * std::vector<Kernel::Point_2> &vertices) \brief Computes the kernel of a
+ * simple polygon. A convex polygon is its own kernel, otherwise the inner
+ * half-planes of the edges and of the sides of the bounding box are sorted by
+ * direction and intersected in \f$ O(n \log n) \f$ time. Each vertex of the
+ * kernel is the crossing of two edge lines, so the exact constructions stay
+ * shallow however many edges the polygon has.
+ * @param vertices - vertices of the polygon, in either orientation
+ * @return vertices of the kernel in counterclockwise order, a degenerate
+ * kernel is a segment or a single point, an empty vector if the polygon is
+ * not star-shaped
+ */
+std::vector<Kernel::Point_2>
+polygon_kernel(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn bool star_shaped_guard(const std::vector<Kernel::Point_2> &vertices,
+ * bool vertex_guard, Kernel::Point_2 &guard) \brief Finds a single guard
+ * seeing the whole polygon. A vertex of the polygon lying in the kernel is
+ * preferred, otherwise the centroid of the kernel vertices is used.
+ * @param vertices - vertices of the polygon
+ * @param vertex_guard - if true, only a vertex of the polygon is accepted
+ * @param guard - set to the found guard
+ * @return true if the guard was found
+ */
+bool star_shaped_guard(const std::vector<Kernel::Point_2> &vertices,
+                       bool vertex_guard, Kernel::Point_2 &guard);
+
+/*! \fn bool star_shaped_solution(const std::vector<Kernel::Point_2>
+ * &vertices, bool vertex_guard, std::vector<Kernel::Point_2> &guards,
+ * std::vector<Arrangement_2> *guard_regions) \brief The check the algorithms
+ * run first. If the polygon is star-shaped, its single guard is an optimal
+ * solution and its visibility region is the whole polygon.
+ * @param vertices - vertices of the polygon
+ * @param vertex_guard - if true, only a vertex of the polygon is accepted
+ * @param guards - set to the single guard if one was found
+ * @param guard_regions - if not null, the polygon is appended as the region
+ * of the guard
+ * @return true if the polygon is solved by one guard
+ */
+bool star_shaped_solution(const std::vector<Kernel::Point_2> &vertices,
+                          bool vertex_guard,
+                          std::vector<Kernel::Point_2> &guards,
+                          std::vector<Arrangement_2> *guard_regions = nullptr);
+
+#endif // AGP_ARRANGEMENT_STAR_SHAPED_H
@@ -10,35 +10,75 @@
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Polygon_2.h>
 #include <CGAL/Polygon_2_algorithms.h>
+#include <agp/parallel/arena.h>
 
 #include <list>
+#include <memory>
 
 using Kernel = CGAL::Exact_predicates_exact_constructions_kernel;
 using Traits = CGAL::Arr_segment_traits_2<Kernel>;
 using Arrangement_2 = CGAL::Arrangement_2<Traits>;
+
+/*! \class Arena_dcel
+ * DCEL of \ref Arena_arrangement_2, its records are allocated by \ref
+ * arena_allocator.
+ */
+template <typename GeomTraits>
+class Arena_dcel
+    : public CGAL::Arr_dcel_base<
+          CGAL::Arr_vertex_base<typename GeomTraits::Point_2>,
+          CGAL::Arr_halfedge_base<typename GeomTraits::X_monotone_curve_2>,
+          CGAL::Arr_face_base, arena_allocator<int>> {
+  public:
+    template <typename T> struct rebind { using other = Arena_dcel<T>; };
+};
+
+/*! \typedef Arena_arrangement_2
+ * An arrangement for temporary use, built inside an \ref arena_scope its
+ * vertices, halfedges and faces are released together with the scope.
+ */
+using Arena_arrangement_2 = CGAL::Arrangement_2<Traits, Arena_dcel<Traits>>;
 using Polygon_2 = CGAL::Polygon_2<Kernel>;
 using v_it = std::vector<Kernel::Point_2>::const_iterator;
 
-/*! \fn Arrangement create_arrangement (const v_it &begin, const v_it &end)
- * \brief Creates an arrangement from points. Points are expected to be vertices
- * of a simple polygon.
+/*! \typedef region_handle
+ * Shared immutable handle to an arrangement, usually a visibility region.
+ * Arrangements have no move constructor, so regions are built once in place
+ * and passed around by handles instead of by value.
+ */
+using region_handle = std::shared_ptr<const Arrangement_2>;
+
+/*! \fn void insert_polygon (Arrangement &arr, const v_it &begin, const v_it
+ * &end) \brief Inserts the boundary of a simple polygon into an arrangement,
+ * so that it can be built in place.
  * @tparam Arrangement - a class of type CGAL::Arrangement_2
+ * @param arr - arrangement the edges are inserted into
  * @param begin - vertices iterator
  * @param end - vertices iterator
- * @return arrangement created from points
  */
 template <typename Arrangement>
-Arrangement create_arrangement(const v_it &begin, const v_it &end) {
+void insert_polygon(Arrangement &arr, const v_it &begin, const v_it &end) {
     std::vector<Kernel::Segment_2> segments;
     auto it = begin;
     for (; std::next(it, 1) != end; ++it) {
         segments.push_back(Kernel::Segment_2(*it, *(it + 1)));
     }
     segments.push_back(Kernel::Segment_2(*it, *begin));
-
-    Arrangement arr;
     CGAL::insert_non_intersecting_curves(arr, segments.begin(), segments.end());
+}
 
+/*! \fn Arrangement create_arrangement (const v_it &begin, const v_it &end)
+ * \brief Creates an arrangement from points. Points are expected to be vertices
+ * of a simple polygon.
+ * @tparam Arrangement - a class of type CGAL::Arrangement_2
+ * @param begin - vertices iterator
+ * @param end - vertices iterator
+ * @return arrangement created from points
+ */
+template <typename Arrangement>
+Arrangement create_arrangement(const v_it &begin, const v_it &end) {
+    Arrangement arr;
+    insert_polygon(arr, begin, end);
     return arr;
 }
 
@@ -77,14 +117,47 @@ Polygon_2 arrangement_to_polygon(const Arrangement_2 &arr);
 std::vector<Polygon_2>
 arrangements_to_polygons(const std::vector<Arrangement_2> &arrangements);
 
-/*! \fn std::vector<Kernel::Point_2> face_vertices (const
- * Arrangement_2::Face_const_handle &face) \brief Returns a vector of face's
- * vertices.
- * @param face - const handle to a face
+/*! \fn std::size_t total_vertices(const std::vector<Arrangement_2>
+ * &arrangements) \brief Sums the numbers of vertices of the arrangements, a
+ * measure of the memory they occupy.
+ * @param arrangements - vector of arrangements
+ * @return total number of vertices
+ */
+std::size_t total_vertices(const std::vector<Arrangement_2> &arrangements);
+
+/*! \fn std::size_t total_vertices(const std::vector<region_handle> &regions)
+ * \brief Sums the numbers of vertices of the shared regions.
+ * @param regions - vector of region handles
+ * @return total number of vertices
+ */
+std::size_t total_vertices(const std::vector<region_handle> &regions);
+
+/*! \fn std::vector<region_handle> share_regions (std::vector<Arrangement_2>
+ * &&regions) \brief Takes over the regions and returns a handle to each of
+ * them. All the handles share ownership of the moved vector, no arrangement
+ * is copied.
+ * @param regions - vector of arrangements, left empty
+ * @return handles to the arrangements, in the same order
+ */
+std::vector<region_handle> share_regions(std::vector<Arrangement_2> &&regions);
+
+/*! \fn std::vector<Kernel::Point_2> face_vertices (const Face_handle &face)
+ * \brief Returns a vector of face's vertices.
+ * @tparam Face_handle - a face handle or iterator of any CGAL::Arrangement_2
+ * @param face - handle to a bounded face
  * @return vertices of the given face
  */
-std::vector<Kernel::Point_2>
-face_vertices(const Arrangement_2::Face_const_handle &face);
+template <typename Face_handle>
+std::vector<Kernel::Point_2> face_vertices(const Face_handle &face) {
+    std::vector<Kernel::Point_2> vertices;
+    auto circ = face->outer_ccb(), curr = circ;
+    auto v = curr->source()->point();
+    do {
+        vertices.push_back(v);
+        v = curr->target()->point();
+    } while (++curr != circ);
+    return vertices;
+}
 
 /*! \fn void print_ccb (typename Arrangement::Ccb_halfedge_const_circulator
  * circ) \brief Prints halfedges of a given connected component boundary.
@@ -170,24 +243,60 @@ template <typename Arrangement> void print_arrangement(const Arrangement &arr) {
     std::cout << "-------------------------------------------\n";
 }
 
+/*! \fn const Arrangement &region_reference (const Arrangement &arr)
+ * \brief Returns the arrangement itself, lets templates accept both
+ * arrangements and region handles.
+ * @tparam Arrangement - a class of type CGAL::Arrangement_2
+ * @param arr - given arrangement
+ * @return the same arrangement
+ */
+template <typename Arrangement>
+const Arrangement &region_reference(const Arrangement &arr) {
+    return arr;
+}
+
+/*! \fn const Arrangement &region_reference (const
+ * std::shared_ptr<const Arrangement> &handle) \brief Returns the arrangement
+ * a handle points to.
+ * @tparam Arrangement - a class of type CGAL::Arrangement_2
+ * @param handle - shared handle to the arrangement
+ * @return the arrangement
+ */
+template <typename Arrangement>
+const Arrangement &
+region_reference(const std::shared_ptr<const Arrangement> &handle) {
+    return *handle;
+}
+
 /*! \fn Arrangement overlay_arrangements (const Arrangement &primary, const
- * std::vector<Arrangement> &arrangements) \brief Constructs an overlay of the
+ * std::vector<Region> &arrangements) \brief Constructs an overlay of the
  * given arrangement starting from the primary arrangement.
  * @tparam Arrangement - a class of type CGAL::Arrangement_2
+ * @tparam Region - Arrangement or a shared handle to it
  * @param primary - primary arrangement
  * @param arrangements - vector of other arrangements to overlay
  * @return result of overlaid arrangements
  */
-template <typename Arrangement>
+template <typename Arrangement, typename Region>
 Arrangement overlay_arrangements(const Arrangement &primary,
-                                 const std::vector<Arrangement> &arrangements) {
-    Arrangement overlay_arrangement = primary;
-    for (const auto &arr : arrangements) {
-        Arrangement arr_output;
-        overlay(overlay_arrangement, arr, arr_output);
-        overlay_arrangement = arr_output;
+                                 const std::vector<Region> &arrangements) {
+    // Partial overlays alternate between two arrangements, chosen so that
+    // the last one is written into the returned object. Assigning the
+    // output of every step would copy its whole DCEL.
+    Arrangement result, scratch;
+    if (arrangements.empty()) {
+        result = primary;
+        return result;
+    }
+    const Arrangement *previous = &primary;
+    for (std::size_t i = 0; i < arrangements.size(); ++i) {
+        Arrangement &output =
+            (arrangements.size() - 1 - i) % 2 == 0 ? result : scratch;
+        output.clear();
+        overlay(*previous, region_reference(arrangements[i]), output);
+        previous = &output;
     }
-    return overlay_arrangement;
+    return result;
 }
 
 #endif // AGP_POLYGON_UTILS_H
@@ -0,0 +1,33 @@
+/*! \file verification.h
+ * \brief Independent check that a set of guards covers a gallery.
+ */
+#ifndef AGP_ARRANGEMENT_VERIFICATION_H
+#define AGP_ARRANGEMENT_VERIFICATION_H
+
+#include <agp/arrangement/utils.h>
+
+#include <vector>
+
+/*! \fn std::vector<Kernel::Point_2> verify_guards(const
+ * std::vector<Kernel::Point_2> &vertices, const std::vector<Kernel::Point_2>
+ * &guards, unsigned threads) \brief Checks whether the guards see the whole
+ * gallery. Guards are split between tasks on the shared thread pool, each
+ * task computes visibility regions of its guards and their union. The unions
+ * are then joined pairwise in parallel, and the union of all regions is
+ * subtracted from the gallery.
+ * The check does not depend on any of the algorithms, so it can be used to
+ * validate their results.
+ * @param vertices - vertices of the gallery in counterclockwise order
+ * @param guards - guards lying inside the gallery or on its boundary
+ * @param threads - number of tasks on the shared thread pool, 0 uses
+ * \ref thread_count
+ * @return points lying in the interior of regions not seen by any guard, at
+ * least one point for each such region, or an empty vector if the guards
+ * cover the gallery
+ */
+std::vector<Kernel::Point_2>
+verify_guards(const std::vector<Kernel::Point_2> &vertices,
+              const std::vector<Kernel::Point_2> &guards,
+              unsigned threads = 0);
+
+#endif // AGP_ARRANGEMENT_VERIFICATION_H
@@ -9,6 +9,7 @@
 #include <CGAL/Arrangement_2.h>
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Triangular_expansion_visibility_2.h>
+#include <agp/arrangement/utils.h>
 
 typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
 typedef CGAL::Arr_segment_traits_2<Kernel> Traits;
@@ -34,6 +35,40 @@ bool point_visible(const Arrangement_2 &arr, const Kernel::Point_2 &point);
 Arrangement_2 general_point_visibility_region(const Arrangement_2 &polygon,
                                               const Kernel::Point_2 &p);
 
+/*! \fn void general_point_visibility_region (const Arrangement_2 &polygon,
+ * const Kernel::Point_2 &p, Arrangement_2 &output) Computes visibility region
+ * of a point \f$ p \f$ directly into the given arrangement, e.g. an element
+ * of a container, as arrangements cannot be moved.
+ * @param polygon - given polygon
+ * @param p - point which visibility region is computed
+ * @param output - empty arrangement the region is written into
+ */
+void general_point_visibility_region(const Arrangement_2 &polygon,
+                                     const Kernel::Point_2 &p,
+                                     Arrangement_2 &output);
+
+/*! \fn region_handle visibility_region_handle (const Arrangement_2 &polygon,
+ * const Kernel::Point_2 &p) Computes visibility region of a point \f$ p \f$
+ * and returns a shared handle to it, the region is never copied.
+ * @param polygon - given polygon
+ * @param p - point which visibility region is computed
+ * @return handle to visibility region of \f$ p \f$
+ */
+region_handle visibility_region_handle(const Arrangement_2 &polygon,
+                                       const Kernel::Point_2 &p);
+
+/*! \fn std::vector<region_handle> visibility_region_handles (const
+ * Arrangement_2 &polygon, const std::vector<Kernel::Point_2> &points) Computes
+ * visibility regions of points lying anywhere in the polygon, sharing one
+ * triangulation of the polygon between them.
+ * @param polygon - polygon which contains all the points
+ * @param points - points which visibility regions are computed
+ * @return handles to visibility regions of the points, in the same order
+ */
+std::vector<region_handle>
+visibility_region_handles(const Arrangement_2 &polygon,
+                          const std::vector<Kernel::Point_2> &points);
+
 /*! \fn Arrangement_2 vertex_point_visibility_region (const Arrangement_2
  * &polygon, const Kernel::Point_2 &p) Computes visibility region of a point \f$
  * p \f$ from a given polygon. Point \f$ p \f$ must be a vertex of the given
@@ -6,6 +6,7 @@
 
 #include <ilcplex/ilocplex.h>
 
+#include <utility>
 #include <vector>
 
 /*! \fn std::vector<int> IP_ind_solution (IloCplex &cplex, IloNumVarArray &x)
@@ -25,6 +26,54 @@ std::vector<int> IP_ind_solution(IloCplex &cplex, IloNumVarArray &x);
  */
 std::vector<IloNum> LP_solution(IloCplex &cplex, IloNumVarArray &x);
 
+/*! \class cplex_threads
+ * \brief Lends idle workers of the shared thread pool to CPLEX. While the
+ * object exists, the reserved workers take no new tasks and CPLEX uses one
+ * thread for each of them plus the calling thread, so solvers running at the
+ * same time together with the pool never use more than \ref thread_count
+ * threads. Workers busy with a task, including the calling thread when it is
+ * a worker, are not lent.
+ */
+class cplex_threads {
+  public:
+    /*! \fn explicit cplex_threads(IloCplex &cplex)
+     * \brief Reserves the idle workers and sets the thread limit of cplex.
+     * @param cplex - object of the IloCplex class
+     */
+    explicit cplex_threads(IloCplex &cplex);
+
+    /// Returns the reserved workers to the pool.
+    ~cplex_threads();
+
+    cplex_threads(const cplex_threads &) = delete;
+    cplex_threads &operator=(const cplex_threads &) = delete;
+
+  private:
+    unsigned reserved_;
+};
+
+/*! \class end_on_exit
+ * \brief Calls a function when leaving its scope, also by an exception. Used
+ * to call end() on Concert objects, which are otherwise kept by their IloEnv
+ * until it ends, and an environment may serve a whole stream of galleries.
+ */
+template <typename F> class end_on_exit {
+  public:
+    /*! \fn explicit end_on_exit(F f)
+     * @param f - function calling end() on the objects of the scope
+     */
+    explicit end_on_exit(F f) : f_(std::move(f)) {}
+
+    /// Calls the function.
+    ~end_on_exit() { f_(); }
+
+    end_on_exit(const end_on_exit &) = delete;
+    end_on_exit &operator=(const end_on_exit &) = delete;
+
+  private:
+    F f_;
+};
+
 /*! \fn std::vector<int> solve_IP_model (IloCplex &cplex, IloModel &model,
  * IloNumVarArray &x) \brief Solves a model of integer programming and returns
  * the solution as indices of elements of x greater than 0.
@@ -36,6 +85,21 @@ std::vector<IloNum> LP_solution(IloCplex &cplex, IloNumVarArray &x);
 std::vector<int> solve_IP_model(IloCplex &cplex, IloModel &model,
                                 IloNumVarArray &x);
 
+/*! \fn std::vector<int> solve_IP_model (IloCplex &cplex, IloModel &model,
+ * IloNumVarArray &x, const std::vector<IloNum> &start) \brief Same as \ref
+ * solve_IP_model, but gives CPLEX a starting solution, which it repairs if
+ * it doesn't satisfy the model.
+ * @param cplex - object of the IloCplex class
+ * @param model - model to be solved
+ * @param x - vector of decision variables
+ * @param start - starting value of each element of x, empty for no start
+ * @return vector of indices of elements that are greater than 0, empty if
+ * CPLEX found no solution, e.g. because a cutoff excluded all of them
+ */
+std::vector<int> solve_IP_model(IloCplex &cplex, IloModel &model,
+                                IloNumVarArray &x,
+                                const std::vector<IloNum> &start);
+
 /*! \fn std::vector<IloNum> solve_LP_model (IloCplex &cplex, IloModel &model,
  * IloNumVarArray &x) \brief Solves a model of linear programming and returns
  * the solution as a vector of all values of x.
@@ -26,11 +26,51 @@ all_vertices(const std::vector<Kernel::Point_2> &vertices);
  * std::vector<Kernel::Point_2> &) Discretization as described in "An exact and
  * efficient algorithm for the orthogonal art gallery problem" by Couto et al.
  * Requirements: a given polygon is orthogonal. Other methods are preferred over
- * this one, as it greatly depends on the area of the polygon.
+ * this one, as it greatly depends on the area of the polygon. Grid points
+ * outside the polygon are left out.
  * @param vertices of a given polygon
  * @return vector of points that form a grid inside the polygon
  */
 std::vector<Kernel::Point_2>
 discretization_min_dist(const std::vector<Kernel::Point_2> &vertices);
 
+/*! \fn std::vector<Kernel::Point_2> orthogonal_grid(const
+ * std::vector<Kernel::Point_2> &vertices) Discretizes an orthogonal polygon to
+ * the centers of the cells of the grid through its vertices (see \ref
+ * orthogonal_cells), which are the regions its coverage is checked on. Other
+ * polygons are discretized to all vertices.
+ * @param vertices of a given polygon
+ * @return vector of cell centers, or of the vertices
+ */
+std::vector<Kernel::Point_2>
+orthogonal_grid(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::vector<Kernel::Point_2> shadow_avp(const
+ * std::vector<Kernel::Point_2> &vertices) Discretizes a polygon to its shadow
+ * atomic visibility polygons, as described in "An exact algorithm for
+ * minimizing vertex guards on art galleries" by Couto et al. Atomic visibility
+ * polygons (AVPs) are the faces of the overlay of the visibility regions of all
+ * vertices. An AVP is a shadow AVP if no neighbouring AVP is seen by fewer
+ * vertices. Every AVP is seen by a superset of the vertices seeing some shadow
+ * AVP, so vertex guards seeing a point of each shadow AVP see the whole
+ * polygon and \ref couto_algorithm needs a single round to find them. One
+ * point is taken for each distinct set of vertices seeing a shadow AVP.
+ * @param vertices of a given polygon
+ * @return vector of interior points of the shadow AVPs
+ */
+std::vector<Kernel::Point_2>
+shadow_avp(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::vector<Kernel::Point_2> reflex_extension(const
+ * std::vector<Kernel::Point_2> &vertices) Discretizes a polygon to one point
+ * in each face of its arrangement with the extensions of the edges at reflex
+ * vertices (see \ref extension_chords). The faces are convex and their number
+ * depends only on the number of reflex vertices, not on the area of the
+ * polygon or the scale of its coordinates.
+ * @param vertices of a given polygon
+ * @return vector of \ref small_interior_point of the faces
+ */
+std::vector<Kernel::Point_2>
+reflex_extension(const std::vector<Kernel::Point_2> &vertices);
+
 #endif // AGP_DISCRETIZATION_METHODS_H
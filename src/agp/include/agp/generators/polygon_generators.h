@@ -0,0 +1,73 @@
+/*! \file polygon_generators.h
+ * \brief Generators of scalable gallery instances.
+ *
+ * All generated polygons are simple, have integer coordinates and are in
+ * counterclockwise order. Random families are deterministic for a given seed
+ * on every platform, since they use only the raw output of std::mt19937_64
+ * and algorithms whose results the standard fixes, such as
+ * std::stable_partition and sorts by strict total orders.
+ * All generators run in \f$ O(n \log n) \f$ expected time, so they can be used
+ * to produce galleries with millions of vertices.
+ */
+#ifndef AGP_GENERATORS_POLYGON_GENERATORS_H
+#define AGP_GENERATORS_POLYGON_GENERATORS_H
+
+#include <agp/arrangement/visibility.h>
+
+#include <cstdint>
+#include <vector>
+
+/*! \fn std::vector<Kernel::Point_2> random_polygon(std::size_t n,
+ * std::uint64_t seed) \brief Generates a random simple polygon with the space
+ * partitioning heuristic of Auer and Held. Vertices are distinct random points
+ * from a \f$ 2^{30} \times 2^{30} \f$ grid. The set is split by the line
+ * through its leftmost and rightmost points and each half is turned into a
+ * chain by recursively splitting it with random lines through random points.
+ * @param n - number of vertices, at least 3
+ * @param seed - seed of the random number generator
+ * @return vertices of the polygon
+ */
+std::vector<Kernel::Point_2> random_polygon(std::size_t n,
+                                            std::uint64_t seed = 0);
+
+/*! \fn std::vector<Kernel::Point_2> orthogonal_polygon(std::size_t n,
+ * std::uint64_t seed) \brief Generates a random x-monotone orthogonal polygon.
+ * The polygon is a row of \f$ n / 4 \f$ unit-width columns, each spanning a
+ * random interval of heights. Neighbouring columns overlap, so the polygon has
+ * reflex vertices both on its top and on its bottom chain.
+ * @param n - number of vertices, rounded down to a multiple of 4, at least 4
+ * @param seed - seed of the random number generator
+ * @return vertices of the polygon
+ */
+std::vector<Kernel::Point_2> orthogonal_polygon(std::size_t n,
+                                                std::uint64_t seed = 0);
+
+/*! \fn std::vector<Kernel::Point_2> von_koch_polygon(unsigned level)
+ * \brief Generates a quadratic von Koch island. Starting from a square, each
+ * edge is replaced by five edges: the middle fifth of the edge is pushed
+ * outwards by a fifth of its length. The polygon has \f$ 4 \cdot 5^{level} \f$
+ * vertices.
+ * @param level - number of refinements, at most 12
+ * @return vertices of the polygon
+ */
+std::vector<Kernel::Point_2> von_koch_polygon(unsigned level);
+
+/*! \fn std::vector<Kernel::Point_2> spiral_polygon(std::size_t n)
+ * \brief Generates a corridor winding around the origin, with \f$ n / 2 \f$
+ * vertices on each of its walls.
+ * @param n - number of vertices, rounded down to an even number, at least 6
+ * @return vertices of the polygon
+ */
+std::vector<Kernel::Point_2> spiral_polygon(std::size_t n);
+
+/*! \fn std::vector<Kernel::Point_2> comb_polygon(std::size_t teeth)
+ * \brief Generates a comb with thin triangular teeth. No point sees the tips
+ * of two teeth, so the comb with \f$ k \f$ teeth and \f$ 3k + 2 \f$ vertices
+ * needs \f$ k \f$ guards, which is close to the \f$ \lfloor n/3 \rfloor \f$
+ * bound of Fisk's algorithm.
+ * @param teeth - number of teeth, at least 1
+ * @return vertices of the polygon
+ */
+std::vector<Kernel::Point_2> comb_polygon(std::size_t teeth);
+
+#endif // AGP_GENERATORS_POLYGON_GENERATORS_H
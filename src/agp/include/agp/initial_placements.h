@@ -9,6 +9,9 @@
 #include <agp/arrangement/utils.h>
 #include <agp/arrangement/visibility.h>
 
+#include <functional>
+#include <string>
+
 /*! \struct wg_placement
  * Used to store potential guards and witnesses used in \ref
  * baumgartner_algorithm.
@@ -16,9 +19,9 @@
 struct wg_placement {
     std::vector<Kernel::Point_2> guards;    /*!< potential guards */
     std::vector<Kernel::Point_2> witnesses; /*!< witnesses of visibility */
-    std::vector<Arrangement_2>
+    std::vector<region_handle>
         guard_visibility; /*!< regions of visibility corresponding to guards */
-    std::vector<Arrangement_2> witness_visibility; /*!< regions of visibility
+    std::vector<region_handle> witness_visibility; /*!< regions of visibility
                                                     * corresponding to witnesses
                                                     */
 };
@@ -32,4 +35,59 @@ struct wg_placement {
  */
 wg_placement every_second(const std::vector<Kernel::Point_2> &vertices);
 
+/*! \fn wg_placement reflex_guards(const std::vector<Kernel::Point_2>
+ * &vertices) Reflex vertices become guards and the convex vertices become
+ * witnesses. Guards of optimal solutions usually lie at or near reflex
+ * vertices, while the convex ones are the hardest to see.
+ * @param vertices of a given polygon
+ * @return an object with vectors of G, W and their visibility regions
+ */
+wg_placement reflex_guards(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn wg_placement convex_witnesses(const std::vector<Kernel::Point_2>
+ * &vertices) All the vertices become guards and an interior point of each
+ * convex component from \ref to_convex_components becomes a witness, so the
+ * first solution already has to see every part of the polygon.
+ * @param vertices of a given polygon
+ * @return an object with vectors of G, W and their visibility regions
+ */
+wg_placement convex_witnesses(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn wg_placement reflex_chords(const std::vector<Kernel::Point_2>
+ * &vertices) Guards are the reflex vertices and the points where the
+ * extensions of their edges into the polygon hit its boundary. Witnesses are
+ * interior points of the convex components, as in \ref convex_witnesses.
+ * @param vertices of a given polygon
+ * @return an object with vectors of G, W and their visibility regions
+ */
+wg_placement reflex_chords(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \typedef placement_method
+ * A function choosing the initial guards and witnesses of \ref
+ * baumgartner_algorithm.
+ */
+using placement_method =
+    std::function<wg_placement(const std::vector<Kernel::Point_2> &)>;
+
+/*! \fn placement_method placement_by_name(const std::string &name)
+ * Looks up a placement by its name: "every_second", "reflex", "convex" or
+ * "chords".
+ * @param name - name of the placement
+ * @return the placement function
+ * @throws std::invalid_argument if there is no such placement
+ */
+placement_method placement_by_name(const std::string &name);
+
+/*! \fn placement_method with_guards(placement_method placement,
+ * std::vector<Kernel::Point_2> guards) Extends a placement with given
+ * candidate guards, e.g. a solution of a simplified gallery (see
+ * multi_resolution.h). Guards outside the polygon or already among the
+ * candidates are skipped.
+ * @param placement - placement to extend
+ * @param guards - additional candidate guards
+ * @return the extended placement
+ */
+placement_method with_guards(placement_method placement,
+                             std::vector<Kernel::Point_2> guards);
+
 #endif // AGP_INITIAL_PLACEMENTS_H
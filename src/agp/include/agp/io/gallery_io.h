@@ -0,0 +1,144 @@
+/*! \file gallery_io.h
+ * \brief Reading and writing galleries in the text (.pol) and the binary
+ * (.agpb) format.
+ *
+ * A binary gallery consists of a \ref gallery_header, a block of coordinates
+ * and an optional block of precomputed \ref gallery_metadata. Depending on
+ * \ref coordinate_type the coordinate block stores for each vertex two int64
+ * values (x, y), two doubles (x, y) or four int64 values (x numerator, x
+ * denominator, y numerator, y denominator). All values are stored in the
+ * native byte order and are aligned to 8 bytes, so the file can be mapped
+ * into memory and read without parsing.
+ */
+#ifndef AGP_IO_GALLERY_IO_H
+#define AGP_IO_GALLERY_IO_H
+
+#include <agp/arrangement/utils.h>
+#include <agp/io/mapped_file.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*! \enum coordinate_type
+ * Representation of coordinates in a binary gallery file.
+ */
+enum class coordinate_type : std::uint32_t {
+    int64 = 0,   /*!< integer coordinates */
+    float64 = 1, /*!< double coordinates */
+    rational = 2 /*!< pairs of int64 numerators and denominators */
+};
+
+/*! \struct gallery_header
+ * Header of a binary gallery file.
+ */
+struct gallery_header {
+    char magic[4];                 /*!< "AGPB" */
+    std::uint32_t version;         /*!< version of the format */
+    coordinate_type coordinates;   /*!< representation of coordinates */
+    std::uint32_t flags;           /*!< bit 0 - metadata block present */
+    std::uint64_t vertex_count;    /*!< number of vertices */
+    std::uint64_t metadata_offset; /*!< offset of the metadata block */
+};
+
+/*! \struct gallery_metadata
+ * Properties of a gallery computed when the binary file was written. The
+ * structure is followed by reflex_count indices (uint64) of reflex vertices.
+ */
+struct gallery_metadata {
+    double min_x; /*!< approximate bounding box of the gallery */
+    double min_y;
+    double max_x;
+    double max_y;
+    std::uint64_t reflex_count;     /*!< number of reflex vertices */
+    std::uint32_t orthogonal;       /*!< 1 if all edges are axis-parallel */
+    std::uint32_t counterclockwise; /*!< 1 if vertices are in ccw order */
+};
+
+/*! \class mapped_gallery
+ * \brief A binary gallery file mapped into memory. Coordinate and metadata
+ * blocks are accessed directly in the mapping. Throws std::runtime_error if
+ * the file cannot be mapped or is not a valid gallery.
+ */
+class mapped_gallery {
+  public:
+    explicit mapped_gallery(const std::string &filename);
+
+    /*! @return header of the file */
+    const gallery_header &header() const;
+
+    /*! @return number of vertices of the gallery */
+    std::size_t size() const;
+
+    /*! @return pointer to the first value of the coordinate block */
+    const void *coordinates() const;
+
+    /*! @return metadata of the gallery or null if the file has none */
+    const gallery_metadata *metadata() const;
+
+    /*! @return indices of reflex vertices or null if the file has no
+     * metadata */
+    const std::uint64_t *reflex_vertices() const;
+
+    /*! \brief Constructs exact points from the coordinate block.
+     * @return vertices of the gallery
+     */
+    std::vector<Kernel::Point_2> points() const;
+
+  private:
+    mapped_file file_;
+};
+
+/*! \fn bool read_pol(std::istream &in, std::vector<Kernel::Point_2> &points)
+ * \brief Reads a gallery in the text format - the number of vertices followed
+ * by their coordinates.
+ * @param in - input stream
+ * @param points - vector the vertices are appended to
+ * @return false if the stream ended or held something else before a gallery
+ * was read
+ */
+bool read_pol(std::istream &in, std::vector<Kernel::Point_2> &points);
+
+/*! \fn void write_pol(std::ostream &out, const std::vector<Kernel::Point_2>
+ * &points) \brief Writes a gallery in the text format, with coordinates as
+ * exact fractions, so that \ref read_pol reads it back unchanged.
+ * @param out - output stream
+ * @param points - vertices of the gallery
+ */
+void write_pol(std::ostream &out, const std::vector<Kernel::Point_2> &points);
+
+/*! \fn std::vector<Kernel::Point_2> read_gallery(const std::string &filename)
+ * \brief Reads a gallery from a file. Files with the .agpb extension are
+ * mapped as binary galleries, other files are parsed as text.
+ * @param filename - path to the file
+ * @return vertices of the gallery
+ */
+std::vector<Kernel::Point_2> read_gallery(const std::string &filename);
+
+/*! \fn coordinate_type narrowest_coordinate_type(const
+ * std::vector<Kernel::Point_2> &points) \brief Finds the most compact
+ * coordinate representation that stores the points exactly.
+ * @param points - vertices of a gallery
+ * @return coordinate_type::int64 or coordinate_type::rational, or
+ * coordinate_type::float64 if some coordinates do not fit in int64 values
+ */
+coordinate_type
+narrowest_coordinate_type(const std::vector<Kernel::Point_2> &points);
+
+/*! \fn void write_gallery_binary(const std::string &filename, const
+ * std::vector<Kernel::Point_2> &points, coordinate_type type, bool
+ * with_metadata) \brief Writes a gallery in the binary format. Coordinates are
+ * rounded if they cannot be represented exactly by the given type.
+ * @param filename - path to the output file
+ * @param points - vertices of the gallery
+ * @param type - representation of coordinates
+ * @param with_metadata - whether to precompute and store the metadata block
+ */
+void write_gallery_binary(const std::string &filename,
+                          const std::vector<Kernel::Point_2> &points,
+                          coordinate_type type, bool with_metadata = true);
+
+#endif // AGP_IO_GALLERY_IO_H
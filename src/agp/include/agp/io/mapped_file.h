@@ -0,0 +1,46 @@
+/*! \file mapped_file.h
+ * \brief Read-only memory mapping of files.
+ */
+#ifndef AGP_IO_MAPPED_FILE_H
+#define AGP_IO_MAPPED_FILE_H
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+/*! \class mapped_file
+ * \brief A file mapped into memory for reading. The mapping is released when
+ * the object is destroyed. Throws std::runtime_error if the file cannot be
+ * opened or mapped.
+ */
+class mapped_file {
+  public:
+    explicit mapped_file(const std::string &filename);
+    ~mapped_file();
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    /*! @return pointer to the first byte of the file */
+    const char *data() const { return data_; }
+
+    /*! @return size of the file in bytes */
+    std::size_t size() const { return size_; }
+
+  private:
+    const char *data_;
+    std::size_t size_;
+};
+
+/*! \class memory_streambuf
+ * \brief A stream buffer reading directly from a block of memory, so that
+ * text formats can be parsed from a \ref mapped_file without copying it.
+ */
+class memory_streambuf : public std::streambuf {
+  public:
+    memory_streambuf(const char *data, std::size_t size) {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+#endif // AGP_IO_MAPPED_FILE_H
@@ -0,0 +1,53 @@
+/*! \file visibility_cache.h
+ * \brief An optional on-disk cache of vertex visibility regions.
+ *
+ * Regions of all vertices of a gallery are stored in one file named after a
+ * hash of the gallery's vertex list. The file keeps the vertex list itself, so
+ * hash collisions are detected, and exact coordinates of every region's
+ * boundary. Cache files are mapped into memory when read. The cache is
+ * disabled until a directory is set.
+ */
+#ifndef AGP_IO_VISIBILITY_CACHE_H
+#define AGP_IO_VISIBILITY_CACHE_H
+
+#include <agp/arrangement/utils.h>
+#include <agp/arrangement/visibility.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! \fn void set_visibility_cache_directory(const std::string &directory)
+ * \brief Enables the cache in a given directory, which must exist. An empty
+ * string disables the cache.
+ * @param directory - path to the cache directory
+ */
+void set_visibility_cache_directory(const std::string &directory);
+
+/*! \fn const std::string &visibility_cache_directory()
+ * @return current cache directory, empty if the cache is disabled
+ */
+const std::string &visibility_cache_directory();
+
+/*! \fn std::uint64_t polygon_hash(const std::vector<Kernel::Point_2>
+ * &vertices) \brief Computes a 64-bit FNV-1a hash of exact coordinates of the
+ * vertices.
+ * @param vertices - vertices of a polygon
+ * @return hash of the vertex list
+ */
+std::uint64_t polygon_hash(const std::vector<Kernel::Point_2> &vertices);
+
+/*! \fn std::vector<Arrangement_2> cached_visibility_regions(const
+ * Arrangement_2 &polygon, const std::vector<Kernel::Point_2> &vertices)
+ * \brief Returns the same regions as \ref all_visibility_regions called for
+ * all vertices of the polygon. If the cache is enabled, the regions are read
+ * from the cache, or computed and stored in it if they are missing.
+ * @param polygon - given polygon
+ * @param vertices - vertices of the polygon in counterclockwise order
+ * @return vector of visibility regions of the vertices
+ */
+std::vector<Arrangement_2>
+cached_visibility_regions(const Arrangement_2 &polygon,
+                          const std::vector<Kernel::Point_2> &vertices);
+
+#endif // AGP_IO_VISIBILITY_CACHE_H
@@ -0,0 +1,163 @@
+/*! \file arena.h
+ * \brief Per-thread arenas for short-lived containers.
+ *
+ * Arrangements and partitions built and destroyed in every iteration of the
+ * algorithms allocate each of their vertices, halfedges and faces separately.
+ * Containers using \ref arena_allocator take this memory from the arena of
+ * the calling thread while an \ref arena_scope is open, and the scope releases
+ * all of it at once when it closes. Without an open scope the allocator uses
+ * the heap, so such containers are always safe to use, but everything
+ * allocated in a scope, including elements added to containers created
+ * before it, must be destroyed before the scope closes. Every thread has its
+ * own arena, so threads never contend for it.
+ */
+#ifndef AGP_PARALLEL_ARENA_H
+#define AGP_PARALLEL_ARENA_H
+
+#include <cstddef>
+#include <list>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*! \class arena
+ * A bump allocator over a list of blocks. Memory is released by rewinding to
+ * an earlier position, the blocks are kept for further allocations.
+ */
+class arena {
+  public:
+    /// Position in the arena returned by \ref mark.
+    struct marker {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    /*! \fn explicit arena(std::size_t block_size)
+     * @param block_size - size of the allocated blocks in bytes
+     */
+    explicit arena(std::size_t block_size = 1 << 16);
+
+    ~arena();
+
+    arena(const arena &) = delete;
+    arena &operator=(const arena &) = delete;
+
+    /*! \fn void *allocate(std::size_t bytes)
+     * @param bytes - size of the memory
+     * @return memory aligned for any scalar type
+     */
+    void *allocate(std::size_t bytes);
+
+    /// @return current position of the arena
+    marker mark() const { return {current_, offset_}; }
+
+    /// Releases all the memory allocated after the given position.
+    void rewind(const marker &position);
+
+    /// @return total size of the blocks in bytes
+    std::size_t capacity() const;
+
+  private:
+    struct block {
+        char *data;
+        std::size_t size;
+    };
+
+    std::size_t block_size_;
+    std::vector<block> blocks_;
+    std::size_t current_ = 0; // block allocated from
+    std::size_t offset_ = 0;  // first free byte of the current block
+};
+
+/*! \fn arena *current_arena()
+ * @return arena of the innermost open \ref arena_scope of the calling thread,
+ * null if there is none
+ */
+arena *current_arena();
+
+/*! \class arena_scope
+ * Makes the arena of the calling thread serve \ref arena_allocator until the
+ * end of the scope and then releases everything allocated in the scope.
+ * Scopes can be nested.
+ */
+class arena_scope {
+  public:
+    arena_scope();
+    ~arena_scope();
+
+    arena_scope(const arena_scope &) = delete;
+    arena_scope &operator=(const arena_scope &) = delete;
+
+  private:
+    arena *previous_;
+    arena::marker start_;
+};
+
+/// Header placed before every block handed out by \ref arena_allocator,
+/// telling whether it comes from an arena.
+union arena_header {
+    bool from_arena;
+    std::max_align_t alignment;
+};
+
+/*! \class arena_allocator
+ * \brief A stateless allocator taking memory from \ref current_arena, or
+ * from the heap if no scope is open.
+ */
+template <typename T> class arena_allocator {
+  public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U> struct rebind { using other = arena_allocator<U>; };
+
+    arena_allocator() = default;
+    template <typename U> arena_allocator(const arena_allocator<U> &) {}
+
+    T *allocate(std::size_t n, const void * = nullptr) {
+        std::size_t bytes = sizeof(arena_header) + n * sizeof(T);
+        arena *a = current_arena();
+        void *memory = a ? a->allocate(bytes) : ::operator new(bytes);
+        auto *header = static_cast<arena_header *>(memory);
+        header->from_arena = a != nullptr;
+        return reinterpret_cast<T *>(header + 1);
+    }
+
+    void deallocate(T *p, std::size_t) {
+        // Arena memory is released together with its scope.
+        auto *header = reinterpret_cast<arena_header *>(p) - 1;
+        if (!header->from_arena)
+            ::operator delete(header);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U *p, Args &&... args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U> void destroy(U *p) { p->~U(); }
+
+    std::size_t max_size() const { return std::size_t(-1) / sizeof(T); }
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T> &, const arena_allocator<U> &) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T> &, const arena_allocator<U> &) {
+    return false;
+}
+
+/*! \typedef arena_list
+ * A list taking its nodes from the current arena.
+ */
+template <typename T> using arena_list = std::list<T, arena_allocator<T>>;
+
+#endif // AGP_PARALLEL_ARENA_H
@@ -0,0 +1,226 @@
+/*! \file thread_pool.h
+ * \brief A work-stealing thread pool shared by the whole library.
+ *
+ * Every worker has its own queue of tasks. Tasks submitted from a worker go to
+ * its queue and are taken from its back, tasks submitted from other threads
+ * are spread between the queues, and idle workers steal from the fronts of
+ * other queues. Threads waiting for a task run pending tasks they submitted
+ * themselves in the meantime, so tasks can wait for tasks they submitted. A
+ * waiting thread never starts a task submitted by another task or thread,
+ * which may be a whole solver job running far longer than the wait.
+ *
+ * Objects of the Epeck kernel count references without synchronisation, so
+ * tasks must not share lazy points or arrangements with other threads. Inputs
+ * of a task should be detached copies (see \ref detached_copy) made by the
+ * submitting thread, and its results are safe to use once its future is
+ * ready.
+ */
+#ifndef AGP_PARALLEL_THREAD_POOL_H
+#define AGP_PARALLEL_THREAD_POOL_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*! \class thread_pool
+ * A fixed number of worker threads with a work-stealing queue each.
+ */
+class thread_pool {
+  public:
+    /*! \fn explicit thread_pool(unsigned workers)
+     * @param workers - number of worker threads, at least 1
+     */
+    explicit thread_pool(unsigned workers);
+
+    /// Finishes all submitted tasks and joins the workers.
+    ~thread_pool();
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    /// @return number of worker threads
+    unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+    /*! \fn std::future<R> submit(F &&f)
+     * \brief Schedules a function to run on a worker.
+     * @param f - function without arguments
+     * @return future of the result of f, it rethrows exceptions thrown by f
+     */
+    template <typename F> auto submit(F &&f) -> std::future<decltype(f())> {
+        using result_type = decltype(f());
+        using function_type = std::optional<std::decay_t<F>>;
+        auto promise = std::make_shared<std::promise<result_type>>();
+        auto function = std::make_shared<function_type>(std::forward<F>(f));
+        auto future = promise->get_future();
+        // The function is destroyed before its result is published, so that
+        // objects it captured aren't released while the waiting thread
+        // already uses the result.
+        push([promise, function] {
+            try {
+                if constexpr (std::is_void_v<result_type>) {
+                    (**function)();
+                    function->reset();
+                    promise->set_value();
+                } else {
+                    result_type result = (**function)();
+                    function->reset();
+                    promise->set_value(std::move(result));
+                }
+            } catch (...) {
+                function->reset();
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return future;
+    }
+
+    /*! \fn bool run_pending_task()
+     * \brief Runs one pending task submitted by the calling thread, or by
+     * the task it is running.
+     * @return false if there was no such task to run
+     */
+    bool run_pending_task();
+
+    /// @return whether the calling thread is a worker of this pool
+    bool is_worker() const;
+
+    /*! \fn T wait(std::future<T> &future)
+     * \brief Waits for a future while running pending tasks submitted by
+     * the calling thread, see \ref run_pending_task.
+     * @param future - future of a task submitted to this pool
+     * @return result of the task
+     */
+    template <typename T> T wait(std::future<T> &future) {
+        while (future.wait_for(std::chrono::seconds(0)) !=
+               std::future_status::ready) {
+            if (!run_pending_task())
+                future.wait_for(std::chrono::microseconds(100));
+        }
+        return future.get();
+    }
+
+    /*! \fn void wait_all(std::vector<std::future<T>> &futures)
+     * \brief Waits until all the futures are ready while running pending
+     * tasks submitted by the calling thread. Their results and exceptions
+     * are then taken with get(), so a failed task never leaves others
+     * running with references to objects of the waiting thread.
+     * @param futures - futures of tasks submitted to this pool
+     */
+    template <typename T> void wait_all(std::vector<std::future<T>> &futures) {
+        for (auto &future : futures) {
+            while (future.wait_for(std::chrono::seconds(0)) !=
+                   std::future_status::ready) {
+                if (!run_pending_task())
+                    future.wait_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    /*! \fn unsigned reserve(unsigned workers)
+     * \brief Stops up to the given number of idle workers from taking new
+     * tasks, so that their cores can be used by threads outside the pool.
+     * Workers running a task are not reserved.
+     * @param workers - number of workers to reserve
+     * @return number of workers actually reserved
+     */
+    unsigned reserve(unsigned workers);
+
+    /*! \fn void release(unsigned workers)
+     * \brief Returns workers reserved by \ref reserve to the pool.
+     * @param workers - number of workers to release
+     */
+    void release(unsigned workers);
+
+  private:
+    struct task {
+        std::function<void()> run;
+        std::size_t owner = 0; // context that submitted the task
+    };
+
+    struct task_queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    void push(std::function<void()> f);
+    bool pop(task &t, std::size_t home, bool own);
+    static void execute(task &t);
+    void work(std::size_t index);
+
+    std::vector<std::unique_ptr<task_queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::size_t pending_ = 0; // tasks in the queues, guarded by mutex_
+    unsigned active_ = 0;     // workers running a task, guarded by mutex_
+    unsigned reserved_ = 0;   // reserved workers, guarded by mutex_
+    bool stop_ = false;       // guarded by mutex_
+    std::size_t next_queue_ = 0;
+};
+
+/*! \fn void set_thread_count(unsigned threads)
+ * \brief Sets the number of threads used by the library, including the thread
+ * calling it. The shared pool is recreated, so it must not be called while
+ * the library runs.
+ * @param threads - number of threads, 0 uses all available cores
+ */
+void set_thread_count(unsigned threads);
+
+/*! \fn unsigned thread_count()
+ * @return number of threads used by the library
+ */
+unsigned thread_count();
+
+/*! \fn thread_pool &default_thread_pool()
+ * \brief Returns the pool shared by the library, with \ref thread_count - 1
+ * workers (at least one). The pool is created on first use.
+ * @return shared pool
+ */
+thread_pool &default_thread_pool();
+
+/*! \fn void parallel_for(std::size_t begin, std::size_t end, const F &f)
+ * \brief Calls f(i) for every i from [begin, end) on the shared pool. The
+ * calling thread takes part in the work. Runs sequentially if the library
+ * uses a single thread.
+ * @param begin - first index
+ * @param end - index after the last one
+ * @param f - function called for every index
+ */
+template <typename F>
+void parallel_for(std::size_t begin, std::size_t end, const F &f) {
+    std::size_t n = end > begin ? end - begin : 0;
+    if (thread_count() <= 1 || n <= 1) {
+        for (std::size_t i = begin; i < end; ++i)
+            f(i);
+        return;
+    }
+
+    auto &pool = default_thread_pool();
+    std::size_t chunks = std::min<std::size_t>(n, 4 * (pool.size() + 1));
+    std::vector<std::future<void>> futures;
+    for (std::size_t c = 0; c < chunks; ++c) {
+        std::size_t lo = begin + n * c / chunks;
+        std::size_t hi = begin + n * (c + 1) / chunks;
+        futures.push_back(pool.submit([&f, lo, hi] {
+            for (std::size_t i = lo; i < hi; ++i)
+                f(i);
+        }));
+    }
+
+    // All chunks must finish before f goes out of scope, even if one throws.
+    pool.wait_all(futures);
+    for (auto &future : futures)
+        future.get();
+}
+
+#endif // AGP_PARALLEL_THREAD_POOL_H
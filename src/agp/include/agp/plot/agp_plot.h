@@ -6,7 +6,9 @@
 
 #include <agp/arrangement/utils.h>
 
+#include <cstddef>
 #include <ostream>
+#include <string>
 
 void print_points(const std::vector<Kernel::Point_2> &points,
                   std::ostream &out);
@@ -24,6 +26,45 @@ void print_region(const std::vector<Kernel::Point_2> &polygon,
 
 void print_region(const Arrangement_2 &region, std::ostream &out);
 
+/*! \class result_writer
+ * \brief Writes polygons, guards and regions in the same format as the print_*
+ * functions, but collects the output in a buffer that is written to the
+ * stream in large blocks. Coordinates are converted to doubles with a given
+ * number of significant digits, or written as exact fractions on request.
+ * Remaining output is flushed when the writer is destroyed.
+ */
+class result_writer {
+  public:
+    /*! @param out - output stream
+     * @param precision - number of significant digits of coordinates, clamped
+     * to [1, 17] since a double has no more
+     * @param exact - write coordinates as exact fractions instead of doubles
+     * @param buffer_size - size of the buffer in bytes
+     */
+    explicit result_writer(std::ostream &out, int precision = 6,
+                           bool exact = false,
+                           std::size_t buffer_size = 1 << 16);
+    ~result_writer();
+    result_writer(const result_writer &) = delete;
+    result_writer &operator=(const result_writer &) = delete;
+
+    void polygon(const std::vector<Kernel::Point_2> &polygon);
+    void guards(const std::vector<Kernel::Point_2> &guards);
+    void region(const Arrangement_2 &region);
+    void flush();
+
+  private:
+    void point(const Kernel::Point_2 &p);
+    void number(const Kernel::FT &v);
+    void reserve();
+
+    std::ostream &out_;
+    std::string buffer_;
+    std::size_t buffer_size_;
+    int precision_;
+    bool exact_;
+};
+
 template <typename Point>
 void print_point(const Point &p, const CGAL::Color &c, std::ostream &out) {
     out << "pnt " << p << " " << c << "\n";
@@ -0,0 +1,30 @@
+/*! \file memory.h
+ * \brief Measurements of the memory used by the process.
+ */
+#ifndef AGP_PROFILE_MEMORY_H
+#define AGP_PROFILE_MEMORY_H
+
+#include <cstddef>
+
+/*! \fn std::size_t heap_in_use()
+ * \brief Returns the number of bytes currently allocated on the heap, or 0 if
+ * it cannot be determined on this platform.
+ * @return number of allocated bytes
+ */
+std::size_t heap_in_use();
+
+/*! \fn std::size_t resident_memory()
+ * \brief Returns the resident set size of the process in bytes, or 0 if it
+ * cannot be determined on this platform.
+ * @return current resident memory
+ */
+std::size_t resident_memory();
+
+/*! \fn std::size_t peak_resident_memory()
+ * \brief Returns the largest resident set size the process has reached, in
+ * bytes.
+ * @return peak resident memory
+ */
+std::size_t peak_resident_memory();
+
+#endif // AGP_PROFILE_MEMORY_H
@@ -0,0 +1,143 @@
+/*! \file profiler.h
+ * \brief Scoped timers and counters measuring phases of the algorithms.
+ *
+ * Profiling is disabled by default. While disabled, a timer or a counter
+ * costs a single check of a global flag. Building with AGP_NO_PROFILE removes
+ * the \ref AGP_PROFILE_SCOPE and \ref AGP_PROFILE_COUNT macros completely.
+ * While enabled, every timed scope is recorded as an event, so the profile can
+ * be written both as a summary and as a trace viewable in chrome://tracing or
+ * Perfetto. Reading the heap size takes a walk over the arenas of the
+ * allocator, so the change of the heap during each scope is measured only if
+ * asked for with \ref set_heap_profiling.
+ */
+#ifndef AGP_PROFILE_PROFILER_H
+#define AGP_PROFILE_PROFILER_H
+
+#include <agp/profile/memory.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+/// Global switch of the profiler, use \ref set_profiling to change it.
+extern std::atomic<bool> profiling_flag;
+
+/// Switch of heap sampling, use \ref set_heap_profiling to change it.
+extern std::atomic<bool> heap_profiling_flag;
+
+/*! \fn void set_profiling(bool enabled)
+ * \brief Enables or disables recording of timers and counters.
+ */
+void set_profiling(bool enabled);
+
+/*! \fn bool profiling_enabled()
+ * @return true if timers and counters are being recorded
+ */
+inline bool profiling_enabled() {
+    return profiling_flag.load(std::memory_order_relaxed);
+}
+
+/*! \fn void set_heap_profiling(bool enabled)
+ * \brief Enables or disables measuring the heap at the start and end of
+ * every timed scope. Disabled by default.
+ */
+void set_heap_profiling(bool enabled);
+
+/*! \fn void reset_profile()
+ * \brief Drops all recorded events and counters and restarts the clock of the
+ * trace.
+ */
+void reset_profile();
+
+/*! \fn void add_to_counter(const char *name, long long value)
+ * \brief Adds a value to a named counter. Does nothing if profiling is
+ * disabled.
+ * @param name - name of the counter, must be a string literal
+ * @param value - value to add
+ */
+void add_to_counter(const char *name, long long value);
+
+/*! \fn void record_maximum(const char *name, long long value)
+ * \brief Keeps the largest value reported for a name, e.g. the size of a
+ * data structure that grows during the algorithm. Does nothing if profiling
+ * is disabled.
+ * @param name - name of the value, must be a string literal
+ * @param value - current value
+ */
+void record_maximum(const char *name, long long value);
+
+/*! \class scoped_timer
+ * Measures the time, and the change of the heap size if heap profiling is
+ * enabled, between its construction and destruction and records them as an
+ * event with a given name.
+ */
+class scoped_timer {
+  public:
+    /*! \fn explicit scoped_timer(const char *name)
+     * @param name - name of the measured phase, must be a string literal
+     */
+    explicit scoped_timer(const char *name)
+        : name_(profiling_enabled() ? name : nullptr),
+          sample_heap_(name_ &&
+                       heap_profiling_flag.load(std::memory_order_relaxed)) {
+        if (name_) {
+            heap_ = sample_heap_ ? heap_in_use() : 0;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~scoped_timer();
+
+    scoped_timer(const scoped_timer &) = delete;
+    scoped_timer &operator=(const scoped_timer &) = delete;
+
+  private:
+    const char *name_;
+    bool sample_heap_;
+    std::size_t heap_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/*! \fn void write_profile_json(std::ostream &out)
+ * \brief Writes a summary of the profile as JSON - the number of calls, the
+ * total time in seconds, the total change of the heap and the largest heap
+ * size at the end of every timer (0 without heap profiling), the value of
+ * every counter and maximum, and the peak resident memory of the process.
+ */
+void write_profile_json(std::ostream &out);
+
+/*! \fn void write_chrome_trace(std::ostream &out)
+ * \brief Writes all recorded events in the Chrome trace event format. Timers
+ * become complete ("X") events, the heap size at their ends, if measured, a
+ * "heap" counter ("C") track, and counters and maximums counter events at the
+ * end of the trace.
+ */
+void write_chrome_trace(std::ostream &out);
+
+#define AGP_PROFILE_CONCAT_(a, b) a##b
+#define AGP_PROFILE_CONCAT(a, b) AGP_PROFILE_CONCAT_(a, b)
+
+#ifdef AGP_NO_PROFILE
+#define AGP_PROFILE_SCOPE(name)
+#define AGP_PROFILE_COUNT(name, value)
+#define AGP_PROFILE_MAX(name, value)
+#else
+/// Times the rest of the enclosing scope.
+#define AGP_PROFILE_SCOPE(name)                                                \
+    scoped_timer AGP_PROFILE_CONCAT(agp_scoped_timer_, __LINE__)(name)
+/// Adds a value to a counter, the value is not evaluated while disabled.
+#define AGP_PROFILE_COUNT(name, value)                                         \
+    do {                                                                       \
+        if (profiling_enabled())                                               \
+            add_to_counter(name, value);                                       \
+    } while (0)
+/// Records a value if it is the largest so far, the value is not evaluated
+/// while disabled.
+#define AGP_PROFILE_MAX(name, value)                                           \
+    do {                                                                       \
+        if (profiling_enabled())                                               \
+            record_maximum(name, value);                                       \
+    } while (0)
+#endif
+
+#endif // AGP_PROFILE_PROFILER_H
@@ -1,31 +1,59 @@
 #include <agp/algo/baumgartner_algorithm.h>
+#include <agp/algo/coverage_reduction.h>
+#include <agp/arrangement/orthogonal.h>
 #include <agp/arrangement/partition.h>
+#include <agp/arrangement/star_shaped.h>
+#include <agp/profile/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 using vec_t = std::vector<Kernel::Point_2>;
 
-void visibility_matrix(const wg_placement &wg, IloEnv &env,
-                       IloArray<IloNumArray> &A) {
-    IloInt w_size = wg.witnesses.size();
-    IloInt g_size = wg.guards.size();
-    for (int i = 0; i < w_size; ++i) {
-        A[i] = IloNumArray(env, g_size);
-        for (int j = 0; j < g_size; ++j) {
-            A[i][j] = point_visible(wg.guard_visibility[j], wg.witnesses[i]);
+void visibility_matrix(const wg_placement &wg, coverage_matrix &coverage) {
+    AGP_PROFILE_SCOPE("visibility_matrix");
+    std::size_t w_size = wg.witnesses.size();
+    std::size_t g_size = wg.guards.size();
+    for (std::size_t i = 0; i < w_size; ++i) {
+        coverage.emplace_back(g_size);
+        for (std::size_t j = 0; j < g_size; ++j) {
+            coverage[i][j] =
+                point_visible(*wg.guard_visibility[j], wg.witnesses[i]);
         }
     }
 }
 
+/// Copies the reduced coverage matrix into the matrix of the LP models.
+void reduced_matrix(const coverage_reduction &reduction, IloEnv &env,
+                    IloArray<IloNumArray> &A) {
+    IloInt g_size = reduction.guards.size();
+    for (IloInt i = 0; i < A.getSize(); ++i) {
+        A[i] = IloNumArray(env, g_size);
+        for (IloInt j = 0; j < g_size; ++j)
+            A[i][j] = reduction.matrix[i][j];
+    }
+}
+
+void add_to_model(IloModel &model, IloExtractableArray &extractables,
+                  const IloExtractable &e) {
+    model.add(e);
+    extractables.add(e);
+}
+
 void guards_model(IloModel &g_model, IloNumVarArray &x,
-                  IloArray<IloNumArray> &A, IloEnv &env) {
+                  IloArray<IloNumArray> &A, IloEnv &env,
+                  IloExtractableArray &extractables) {
     auto w_size = A.getSize();
     for (int i = 0; i < w_size; ++i) {
-        g_model.add(IloScalProd(A[i], x) >= 1);
+        add_to_model(g_model, extractables, IloScalProd(A[i], x) >= 1);
     }
-    g_model.add(IloMinimize(env, IloSum(x)));
+    add_to_model(g_model, extractables, IloMinimize(env, IloSum(x)));
 }
 
 void witnesses_model(IloModel &w_model, IloNumVarArray &y,
-                     IloArray<IloNumArray> &A, IloEnv &env) {
+                     IloArray<IloNumArray> &A, IloEnv &env,
+                     IloExtractableArray &extractables) {
     auto w_size = A.getSize();
     auto g_size = A[0].getSize();
     for (int j = 0; j < g_size; ++j) {
@@ -33,9 +61,10 @@ void witnesses_model(IloModel &w_model, IloNumVarArray &y,
         for (int i = 0; i < w_size; ++i) {
             row[i] = A[i][j];
         }
-        w_model.add(IloScalProd(row, y) <= 1);
+        add_to_model(w_model, extractables, IloScalProd(row, y) <= 1);
+        row.end();
     }
-    w_model.add(IloMaximize(env, IloSum(y)));
+    add_to_model(w_model, extractables, IloMaximize(env, IloSum(y)));
 }
 
 bool integral_solution(const std::vector<IloNum> &sol) {
@@ -48,28 +77,28 @@ bool integral_solution(const std::vector<IloNum> &sol) {
 
 Arrangement_2
 overlay_arrangements(const Arrangement_2 &primary,
-                     const std::vector<Arrangement_2> &arrangements,
+                     const std::vector<region_handle> &regions,
                      const std::vector<int> &chosen) {
-    Arrangement_2 arrangement = primary;
-    for (const auto &i : chosen) {
-        Arrangement_2 arr_output;
-        overlay(arrangement, arrangements[i], arr_output);
-        arrangement = arr_output;
-    }
-    return arrangement;
+    AGP_PROFILE_SCOPE("overlay");
+    std::vector<region_handle> chosen_regions;
+    chosen_regions.reserve(chosen.size());
+    for (const auto &i : chosen)
+        chosen_regions.push_back(regions[i]);
+    return overlay_arrangements(primary, chosen_regions);
 }
 
 vec_t primary_separation(const Arrangement_2 &guards_overlay,
                          const std::vector<int> &curr_g,
                          const std::vector<IloNum> &x,
-                         const std::vector<Arrangement_2> &guard_visibility) {
+                         const std::vector<region_handle> &guard_visibility) {
+    AGP_PROFILE_SCOPE("primary_separation");
     vec_t found_witnesses;
     auto points = arr_discretization(guards_overlay);
     for (const auto &c : points) {
         IloNum sum = 0;
         for (unsigned i = 0; i < curr_g.size() && sum < 1; ++i) {
             auto ind = curr_g[i];
-            sum += x[ind] * point_visible(guard_visibility[ind], c);
+            sum += x[ind] * point_visible(*guard_visibility[ind], c);
         }
         if (sum < 1)
             found_witnesses.push_back(c);
@@ -80,7 +109,8 @@ vec_t primary_separation(const Arrangement_2 &guards_overlay,
 vec_t dual_separation(const Arrangement_2 &witnesses_overlay,
                       const std::vector<int> &curr_w,
                       const std::vector<IloNum> &y,
-                      const std::vector<Arrangement_2> &witness_visibility) {
+                      const std::vector<region_handle> &witness_visibility) {
+    AGP_PROFILE_SCOPE("dual_separation");
     vec_t found_guards;
     auto points = arr_discretization(witnesses_overlay);
     for (const auto &c : points) {
@@ -89,7 +119,7 @@ vec_t dual_separation(const Arrangement_2 &witnesses_overlay,
         IloNum guards = 0;
         for (unsigned i = 0; guards <= 1 && i < curr_w.size(); ++i) {
             auto ind = curr_w[i];
-            guards += y[ind] * point_visible(witness_visibility[ind], c);
+            guards += y[ind] * point_visible(*witness_visibility[ind], c);
         }
         if (guards > 1)
             found_guards.push_back(c);
@@ -97,6 +127,31 @@ vec_t dual_separation(const Arrangement_2 &witnesses_overlay,
     return found_guards;
 }
 
+/// Lower bound on the number of guards from a solution of the dual LP. A
+/// point on an edge or a vertex of the overlay of the chosen witness regions
+/// sees every witness seen from the faces around it, so the largest value
+/// seen from a vertex of the overlay scales the solution to one feasible for
+/// every point of the polygon as a guard. Its value bounds the optimum of
+/// the relaxation and so of the gallery.
+unsigned long
+dual_lower_bound(const Arrangement_2 &witnesses_overlay,
+                 const std::vector<int> &curr_w, const std::vector<IloNum> &y,
+                 const std::vector<region_handle> &witness_visibility) {
+    AGP_PROFILE_SCOPE("dual_bound");
+    IloNum value = 0, load = 1;
+    for (auto i : curr_w)
+        value += y[i];
+    for (auto v = witnesses_overlay.vertices_begin();
+         v != witnesses_overlay.vertices_end(); ++v) {
+        IloNum seen = 0;
+        for (auto i : curr_w)
+            seen += y[i] * point_visible(*witness_visibility[i], v->point());
+        load = std::max(load, seen);
+    }
+    // the LP solution is exact only up to the tolerance of the solver
+    return static_cast<unsigned long>(std::ceil(value / load - 1e-6));
+}
+
 std::vector<int> LP_chosen(std::vector<IloNum> &solution) {
     std::vector<int> v;
     for (unsigned i = 0; i < solution.size(); ++i)
@@ -105,46 +160,137 @@ std::vector<int> LP_chosen(std::vector<IloNum> &solution) {
     return v;
 }
 
+void compact(const Arrangement_2 &polygon, const wg_placement &wg,
+             compaction_stats *stats) {
+    AGP_PROFILE_SCOPE("compaction");
+    std::size_t heap_before = heap_in_use();
+    exactify(polygon);
+    exactify(wg.guards);
+    exactify(wg.witnesses);
+    exactify(wg.guard_visibility);
+    exactify(wg.witness_visibility);
+    record_compaction(heap_before, stats);
+}
+
 vec_t baumgartner_algorithm(
     const vec_t &points,
     std::function<wg_placement(const vec_t &)> initial_placement_method,
-    int sec) {
+    int sec, unsigned compaction_interval, compaction_stats *stats,
+    std::vector<Arrangement_2> *guard_regions,
+    const progress_callback &progress) {
+    IloEnv env;
+    try {
+        auto solution =
+            baumgartner_algorithm(env, points, initial_placement_method, sec,
+                                  compaction_interval, stats, guard_regions,
+                                  progress);
+        env.end();
+        return solution;
+    } catch (...) {
+        env.end();
+        throw;
+    }
+}
+
+vec_t baumgartner_algorithm(
+    IloEnv &env, const vec_t &points,
+    std::function<wg_placement(const vec_t &)> initial_placement_method,
+    int sec, unsigned compaction_interval, compaction_stats *stats,
+    std::vector<Arrangement_2> *guard_regions,
+    const progress_callback &progress) {
+    AGP_PROFILE_SCOPE("baumgartner");
+    vec_t single_guard;
+    if (star_shaped_solution(points, false, single_guard, guard_regions))
+        return single_guard;
     clock_t begin = clock(), end;
+    auto start = std::chrono::steady_clock::now();
     auto polygon = create_arrangement<Arrangement_2>(points);
-    wg_placement wg = initial_placement_method(points);
-
-    IloEnv env;
-    IloInt w_size = wg.witnesses.size(), g_size;
-    IloArray<IloNumArray> A(env, w_size);
+    wg_placement wg;
+    {
+        AGP_PROFILE_SCOPE("initial_placement");
+        wg = initial_placement_method(points);
+    }
 
-    visibility_matrix(wg, env, A);
+    IloInt w_size, g_size;
+    coverage_matrix coverage;
+    visibility_matrix(wg, coverage);
 
     IloCplex cplex(env);
+    end_on_exit end_cplex([&cplex] { cplex.end(); });
     cplex.setOut(env.getNullStream());
 
     bool witness_found, guard_found;
-    unsigned long lower_bound = 0, upper_bound = points.size() / 3;
+    unsigned long lower_bound = 0, upper_bound = guard_upper_bound(points);
     std::vector<int> g_chosen, w_chosen;
     std::vector<IloNum> x_solved, y_solved;
-    unsigned long current_best_size = points.size() / 3 + 1;
+    unsigned long current_best_size = upper_bound + 1;
     std::vector<int> current_best;
+    unsigned long iteration = 0;
     do {
+        AGP_PROFILE_SCOPE("iteration");
+        AGP_PROFILE_COUNT("iterations", 1);
+        // Temporary arrangements and partitions of the iteration are
+        // released at its end in one go.
+        arena_scope iteration_arena;
         witness_found = false;
         guard_found = false;
         w_size = wg.witnesses.size();
         g_size = wg.guards.size();
+        AGP_PROFILE_MAX("visibility_matrix_entries", w_size * g_size);
+        AGP_PROFILE_MAX("stored_region_vertices",
+                        total_vertices(wg.guard_visibility) +
+                            total_vertices(wg.witness_visibility));
+
+        // Both LPs are built from the reduced coverage matrix, their
+        // solutions are mapped back to all the guards and witnesses.
+        coverage_reduction reduction;
+        {
+            AGP_PROFILE_SCOPE("reduction");
+            reduction = reduce_coverage(coverage, g_size);
+        }
+        IloInt reduced_w = reduction.witnesses.size();
+        IloInt reduced_g = reduction.guards.size();
+        AGP_PROFILE_COUNT("lp_rows", reduced_w);
+        AGP_PROFILE_COUNT("lp_columns", reduced_g);
+        AGP_PROFILE_COUNT("forced_guards", reduction.forced.size());
 
-        IloNumVarArray x(env, g_size, 0, 1);
+        IloArray<IloNumArray> A(env, reduced_w);
+        reduced_matrix(reduction, env, A);
+        IloNumVarArray x(env, reduced_g, 0, 1);
         IloModel g_model(env);
-        IloNumVarArray y(env, w_size, 0, 1);
+        IloNumVarArray y(env, reduced_w, 0, 1);
         IloModel w_model(env);
+        IloExtractableArray extractables(env);
+        end_on_exit end_models([&] {
+            w_model.end();
+            g_model.end();
+            extractables.endElements();
+            extractables.end();
+            x.endElements();
+            x.end();
+            y.endElements();
+            y.end();
+            for (IloInt i = 0; i < A.getSize(); ++i)
+                A[i].end();
+            A.end();
+        });
 
-        guards_model(g_model, x, A, env);
-
-        witnesses_model(w_model, y, A, env);
-
-        x_solved = solve_LP_model(cplex, g_model, x);
-        y_solved = solve_LP_model(cplex, w_model, y);
+        std::vector<IloNum> x_reduced, y_reduced;
+        // the forced guards alone may already see every witness
+        if (reduced_w) {
+            {
+                AGP_PROFILE_SCOPE("lp_model");
+                guards_model(g_model, x, A, env, extractables);
+                witnesses_model(w_model, y, A, env, extractables);
+            }
+            {
+                AGP_PROFILE_SCOPE("lp_solve");
+                x_reduced = solve_LP_model(cplex, g_model, x);
+                y_reduced = solve_LP_model(cplex, w_model, y);
+            }
+        }
+        x_solved = expand_guard_values(reduction, x_reduced);
+        y_solved = expand_witness_values(reduction, y_reduced);
 
         g_chosen = LP_chosen(x_solved);
         w_chosen = LP_chosen(y_solved);
@@ -153,18 +299,25 @@ vec_t baumgartner_algorithm(
             overlay_arrangements(polygon, wg.guard_visibility, g_chosen);
         Arrangement_2 witnesses_arrangement =
             overlay_arrangements(polygon, wg.witness_visibility, w_chosen);
+        AGP_PROFILE_COUNT("overlay_faces",
+                          guards_arrangement.number_of_faces() +
+                              witnesses_arrangement.number_of_faces());
+        AGP_PROFILE_MAX("overlay_vertices",
+                        std::max(guards_arrangement.number_of_vertices(),
+                                 witnesses_arrangement.number_of_vertices()));
 
         auto W = primary_separation(guards_arrangement, g_chosen, x_solved,
                                     wg.guard_visibility);
+        AGP_PROFILE_COUNT("witnesses_added", W.size());
         for (const auto &w : W) {
+            AGP_PROFILE_SCOPE("witness_visibility");
             witness_found = true;
             wg.witnesses.push_back(w);
             wg.witness_visibility.push_back(
-                general_point_visibility_region(polygon, w));
-            A.add(IloNumArray(env, g_size));
-            int n = static_cast<int>(A.getSize() - 1);
+                visibility_region_handle(polygon, w));
+            coverage.emplace_back(g_size);
             for (int j = 0; j < g_size; ++j) {
-                A[n][j] = point_visible(wg.guard_visibility[j], w);
+                coverage.back()[j] = point_visible(*wg.guard_visibility[j], w);
             }
         }
 
@@ -179,31 +332,56 @@ vec_t baumgartner_algorithm(
 
         auto G = dual_separation(witnesses_arrangement, w_chosen, y_solved,
                                  wg.witness_visibility);
+        AGP_PROFILE_COUNT("guards_added", G.size());
         for (const auto &g : G) {
+            AGP_PROFILE_SCOPE("guard_visibility");
             guard_found = true;
             wg.guards.push_back(g);
             wg.guard_visibility.push_back(
-                general_point_visibility_region(polygon, g));
+                visibility_region_handle(polygon, g));
             unsigned long n = wg.guards.size() - 1;
-            for (int i = 0; i < A.getSize(); ++i) {
-                A[i].add(
-                    point_visible(wg.guard_visibility[n], wg.witnesses[i]));
+            for (std::size_t i = 0; i < coverage.size(); ++i) {
+                coverage[i].push_back(
+                    point_visible(*wg.guard_visibility[n], wg.witnesses[i]));
             }
         }
-        if (!guard_found && lower_bound < g_chosen.size())
-            lower_bound = g_chosen.size();
+        // The number of guards in the LP solution isn't a bound, a fractional
+        // solution may spread over more guards than the optimum needs.
+        if (!guard_found)
+            lower_bound = std::max(
+                lower_bound, dual_lower_bound(witnesses_arrangement, w_chosen,
+                                              y_solved, wg.witness_visibility));
 
-        w_model.end();
-        g_model.end();
+        ++iteration;
+        if (compaction_interval && iteration % compaction_interval == 0)
+            compact(polygon, wg, stats);
 
         end = clock();
 
+        if (progress) {
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            iteration_progress state;
+            state.iteration = iteration;
+            state.elapsed = elapsed.count();
+            state.lower_bound = lower_bound;
+            state.upper_bound = upper_bound;
+            state.guards = wg.guards.size();
+            state.witnesses = wg.witnesses.size();
+            for (auto i : current_best)
+                state.incumbent.push_back(wg.guards[i]);
+            if (!progress(state))
+                break;
+        }
+
     } while ((witness_found || guard_found) && lower_bound < upper_bound &&
              double(end - begin) / CLOCKS_PER_SEC < sec);
 
     vec_t solution;
     for (auto i : current_best) {
         solution.push_back(wg.guards[i]);
+        if (guard_regions)
+            guard_regions->push_back(*wg.guard_visibility[i]);
     }
     return solution;
 }
@@ -1,78 +1,228 @@
 #include <agp/algo/couto_algorithm.h>
+#include <agp/algo/coverage_reduction.h>
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/star_shaped.h>
+#include <agp/io/visibility_cache.h>
 #include <agp/plot/agp_plot.h>
+#include <agp/profile/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
 
 using vec_t = std::vector<Kernel::Point_2>;
 
-std::vector<Polygon_with_holes_2>
-uncovered_regions(Polygon_2 &polygon,
-                  std::vector<Polygon_2> visibility_polygons,
-                  std::vector<int> guards);
+void add_coverage_rows(const vec_t &witnesses,
+                       const std::vector<Arrangement_2> &visibility_regions,
+                       coverage_matrix &coverage);
 
-void create_model(const vec_t &discretization,
-                  const std::vector<Arrangement_2> &visibility_regions,
-                  IloEnv &env, IloModel &model, IloNumVarArray &x);
+bool solve_reduced_model(IloEnv &env, IloCplex &cplex,
+                         const coverage_reduction &reduction,
+                         const std::vector<bool> &start, unsigned long cutoff,
+                         std::vector<int> &chosen);
 
 vec_t couto_algorithm(
     const vec_t &points,
-    const std::function<vec_t(const vec_t &)> &discretization_method) {
+    const std::function<vec_t(const vec_t &)> &discretization_method,
+    unsigned compaction_interval, compaction_stats *stats,
+    std::vector<Arrangement_2> *guard_regions,
+    const progress_callback &progress, const vec_t &mip_start,
+    const std::function<unsigned long()> &cutoff) {
+    IloEnv env;
+    try {
+        auto solution =
+            couto_algorithm(env, points, discretization_method,
+                            compaction_interval, stats, guard_regions,
+                            progress, mip_start, cutoff);
+        env.end();
+        return solution;
+    } catch (...) {
+        env.end();
+        throw;
+    }
+}
+
+vec_t couto_algorithm(
+    IloEnv &env, const vec_t &points,
+    const std::function<vec_t(const vec_t &)> &discretization_method,
+    unsigned compaction_interval, compaction_stats *stats,
+    std::vector<Arrangement_2> *guard_regions,
+    const progress_callback &progress, const vec_t &mip_start,
+    const std::function<unsigned long()> &cutoff) {
+    AGP_PROFILE_SCOPE("couto");
+    vec_t single_guard;
+    if (star_shaped_solution(points, true, single_guard, guard_regions))
+        return single_guard;
+    auto start = std::chrono::steady_clock::now();
     auto arr_polygon = create_arrangement<Arrangement_2>(points);
     Polygon_2 polygon = create_polygon(points);
 
-    std::vector<Arrangement_2> visibility_regions =
-        all_visibility_regions(arr_polygon, points);
-    std::vector<Polygon_2> visibility_polygons =
-        arrangements_to_polygons(visibility_regions);
-    vec_t discretization = discretization_method(points);
-
-    IloEnv env;
-    IloInt n = points.size();
-    IloNumVarArray x(env, n, 0, 1, ILOINT);
-    IloModel model(env);
+    std::vector<Arrangement_2> visibility_regions;
+    std::vector<Polygon_2> visibility_polygons;
+    {
+        AGP_PROFILE_SCOPE("visibility");
+        visibility_regions = cached_visibility_regions(arr_polygon, points);
+        visibility_polygons = arrangements_to_polygons(visibility_regions);
+    }
+    vec_t discretization;
+    {
+        AGP_PROFILE_SCOPE("discretization");
+        discretization = discretization_method(points);
+    }
+    // The coverage of an orthogonal gallery is first checked cell by cell,
+    // the uncovered regions are computed only if some cell isn't seen by a
+    // single guard. The grid can have O(n^2) cells, and the check pays off
+    // only while they are few compared to the witnesses, see BM_cells_seen
+    // and BM_uncovered_regions.
+    const std::size_t cells_per_witness = 4;
+    bool cell_check = is_orthogonal(points) &&
+                      grid_cell_bound(points) <=
+                          cells_per_witness * discretization.size();
+    std::vector<grid_cell> cells;
+    if (cell_check)
+        cells = orthogonal_cells(points);
+    AGP_PROFILE_COUNT("grid_cells", cells.size());
+    unsigned long upper_bound = guard_upper_bound(points);
 
-    create_model(discretization, visibility_regions, env, model, x);
+    std::size_t n = points.size();
+    std::vector<bool> start_guards;
+    if (!mip_start.empty()) {
+        start_guards.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+            start_guards[i] = std::find(mip_start.begin(), mip_start.end(),
+                                        points[i]) != mip_start.end();
+    }
+    coverage_matrix coverage;
+    {
+        AGP_PROFILE_SCOPE("coverage");
+        add_coverage_rows(discretization, visibility_regions, coverage);
+    }
+    AGP_PROFILE_MAX("stored_region_vertices",
+                    total_vertices(visibility_regions));
 
     IloCplex cplex(env);
+    end_on_exit end_cplex([&cplex] { cplex.end(); });
     cplex.setOut(env.getNullStream());
 
     bool regions_to_cover;
     std::vector<int> guards;
+    unsigned long iteration = 0;
+    std::size_t witnesses = discretization.size();
+
+    auto iteration_state = [&](unsigned long finished,
+                               unsigned long lower_bound,
+                               unsigned long upper_bound,
+                               const std::vector<int> &incumbent) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        iteration_progress state;
+        state.iteration = finished;
+        state.elapsed = elapsed.count();
+        state.lower_bound = lower_bound;
+        state.upper_bound = upper_bound;
+        state.guards = points.size();
+        state.witnesses = witnesses;
+        for (const auto i : incumbent)
+            state.incumbent.push_back(points[i]);
+        return state;
+    };
 
     do {
-        cplex.extract(model);
-        cplex.solve();
-        guards = IP_ind_solution(cplex, x);
+        AGP_PROFILE_SCOPE("iteration");
+        AGP_PROFILE_COUNT("iterations", 1);
+        // Temporary arrangements and partitions of the iteration are
+        // released at its end in one go.
+        arena_scope iteration_arena;
+        // The IP is built from the reduced coverage matrix, which is usually
+        // much smaller than the matrix of all witnesses and vertices.
+        coverage_reduction reduction;
+        {
+            AGP_PROFILE_SCOPE("reduction");
+            reduction = reduce_coverage(coverage, n);
+        }
+        AGP_PROFILE_COUNT("ip_rows", reduction.witnesses.size());
+        AGP_PROFILE_COUNT("ip_columns", reduction.guards.size());
+        AGP_PROFILE_COUNT("forced_guards", reduction.forced.size());
+        unsigned long known = cutoff ? cutoff() : 0;
+        bool improvable;
+        {
+            AGP_PROFILE_SCOPE("ip_solve");
+            std::vector<int> chosen;
+            improvable = solve_reduced_model(env, cplex, reduction,
+                                             start_guards, known, chosen);
+            guards = expand_guards(reduction, chosen);
+        }
+        if (!improvable) {
+            // The IP optimum, a lower bound of the final one, is at least the
+            // size of the known solution.
+            AGP_PROFILE_COUNT("cutoff_stops", 1);
+            regions_to_cover = true;
+            if (progress)
+                progress(iteration_state(++iteration, known, known, {}));
+            break;
+        }
 
-        std::vector<Polygon_with_holes_2> ur =
-            uncovered_regions(polygon, visibility_polygons, guards);
+        bool covered = false;
+        if (cell_check) {
+            AGP_PROFILE_SCOPE("cell_coverage");
+            covered = cells_seen(cells, visibility_regions, guards);
+        }
+        std::vector<Polygon_with_holes_2> ur;
+        if (!covered)
+            ur = uncovered_regions(polygon, visibility_polygons, guards);
         regions_to_cover = !ur.empty();
+        AGP_PROFILE_COUNT("uncovered_regions", ur.size());
         for (const auto &r : ur) {
-            auto arr = create_arrangement<Arrangement_2>(
+            AGP_PROFILE_SCOPE("separation");
+            auto arr = create_arrangement<Arena_arrangement_2>(
                 r.outer_boundary().vertices_begin(),
                 r.outer_boundary().vertices_end());
             auto to_add = arr_discretization(arr);
+            AGP_PROFILE_COUNT("witnesses_added", to_add.size());
+            witnesses += to_add.size();
+            add_coverage_rows(vec_t(to_add.begin(), to_add.end()),
+                              visibility_regions, coverage);
+        }
 
-            for (const auto &c : to_add) {
-                IloIntArray new_row(env, n);
-                for (int j = 0; j < n; ++j) {
-                    bool a = point_visible(visibility_regions[j], c);
-                    new_row[j] = a;
-                }
-                model.add(IloScalProd(new_row, x) >= 1);
-            }
+        ++iteration;
+        if (compaction_interval && iteration % compaction_interval == 0) {
+            AGP_PROFILE_SCOPE("compaction");
+            std::size_t heap_before = heap_in_use();
+            exactify(discretization);
+            exactify(visibility_regions);
+            exactify(visibility_polygons);
+            record_compaction(heap_before, stats);
         }
+
+        // The IP optimum over a discretization bounds the optimum over the
+        // whole polygon from below, at most n / 3 vertex guards, or n / 4 in
+        // an orthogonal polygon, are ever needed.
+        if (progress &&
+            !progress(iteration_state(
+                iteration, guards.size(),
+                regions_to_cover ? upper_bound : guards.size(),
+                regions_to_cover ? std::vector<int>() : guards)))
+            break;
     } while (regions_to_cover);
 
+    // Stopped before the guards covered the polygon.
+    if (regions_to_cover)
+        guards.clear();
+
     vec_t final_solution;
     for (const auto i : guards) {
         final_solution.push_back(points[i]);
+        if (guard_regions)
+            guard_regions->push_back(visibility_regions[i]);
     }
     return final_solution;
 }
 
 std::vector<Polygon_with_holes_2>
-uncovered_regions(Polygon_2 &polygon,
-                  std::vector<Polygon_2> visibility_polygons,
-                  std::vector<int> guards) {
+uncovered_regions(const Polygon_2 &polygon,
+                  const std::vector<Polygon_2> &visibility_polygons,
+                  const std::vector<int> &guards) {
+    AGP_PROFILE_SCOPE("uncovered_regions");
     std::vector<Polygon_with_holes_2> result;
     Polygon_2 empty;
     CGAL::difference(polygon, empty, std::back_inserter(result));
@@ -82,23 +232,70 @@ uncovered_regions(Polygon_2 &polygon,
         for (const auto &result_polygon : result)
             CGAL::difference(result_polygon, visibility_polygons[i],
                              std::back_inserter(tmp));
-        result = tmp;
+        result.swap(tmp);
     }
     return result;
 }
 
-void create_model(const vec_t &discretization,
-                  const std::vector<Arrangement_2> &visibility_regions,
-                  IloEnv &env, IloModel &model, IloNumVarArray &x) {
-    IloInt n = visibility_regions.size();
-    IloInt m = discretization.size();
-    for (IloInt i = 0; i < m; ++i) {
+void add_coverage_rows(const vec_t &witnesses,
+                       const std::vector<Arrangement_2> &visibility_regions,
+                       coverage_matrix &coverage) {
+    for (const auto &w : witnesses) {
+        boost::dynamic_bitset<> row(visibility_regions.size());
+        for (std::size_t j = 0; j < visibility_regions.size(); ++j)
+            row[j] = point_visible(visibility_regions[j], w);
+        coverage.push_back(std::move(row));
+    }
+}
+
+/// Solves the IP of the reduced matrix, returns false if it has no solution
+/// with fewer guards in total than a nonzero cutoff.
+bool solve_reduced_model(IloEnv &env, IloCplex &cplex,
+                         const coverage_reduction &reduction,
+                         const std::vector<bool> &start, unsigned long cutoff,
+                         std::vector<int> &chosen) {
+    chosen.clear();
+    std::size_t forced = reduction.forced.size();
+    if (cutoff && forced >= cutoff)
+        return false;
+    // the forced guards already cover every witness
+    if (reduction.witnesses.empty())
+        return true;
+    IloInt n = reduction.guards.size();
+    IloNumVarArray x(env, n, 0, 1, ILOINT);
+    IloModel model(env);
+    IloExtractableArray extractables(env);
+    end_on_exit end_model([&] {
+        model.end();
+        extractables.endElements();
+        extractables.end();
+        x.endElements();
+        x.end();
+    });
+    for (const auto &coverage_row : reduction.matrix) {
         IloIntArray row(env, n);
-        for (int j = 0; j < n; ++j) {
-            row[j] = point_visible(visibility_regions[j], discretization[i]);
-        }
-        model.add(IloScalProd(row, x) >= 1);
+        end_on_exit end_row([&row] { row.end(); });
+        for (IloInt j = 0; j < n; ++j)
+            row[j] = coverage_row[j];
+        IloRange constraint = IloScalProd(row, x) >= 1;
+        model.add(constraint);
+        extractables.add(constraint);
     }
+    IloObjective objective = IloMinimize(env, IloSum(x));
+    model.add(objective);
+    extractables.add(objective);
 
-    model.add(IloMinimize(env, IloSum(x)));
+    std::vector<IloNum> start_values;
+    if (!start.empty()) {
+        for (auto j : reduction.guards)
+            start_values.push_back(start[j]);
+    }
+    // objective values are integers, so the cutoff between the last
+    // improving value and the known one discards only worse solutions
+    cplex.setParam(IloCplex::Param::MIP::Tolerances::UpperCutoff,
+                   cutoff ? double(cutoff - forced) - 0.5 : 1e75);
+    chosen = solve_IP_model(cplex, model, x, start_values);
+    if (chosen.empty() && !cutoff)
+        throw std::runtime_error("CPLEX found no solution of the IP model");
+    return !chosen.empty();
 }
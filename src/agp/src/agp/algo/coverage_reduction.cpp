@@ -0,0 +1,157 @@
+#include <agp/algo/coverage_reduction.h>
+
+using bitset = boost::dynamic_bitset<>;
+
+/// Fixes the guards that are the only ones seeing a kept witness and drops the
+/// witnesses they see.
+bool fix_forced_guards(const coverage_matrix &matrix, bitset &witnesses,
+                       bitset &guards, coverage_reduction &reduction) {
+    bool changed = false;
+    for (auto i = witnesses.find_first(); i != bitset::npos;
+         i = witnesses.find_next(i)) {
+        bitset seen_by = matrix[i] & guards;
+        if (seen_by.count() != 1)
+            continue;
+        auto g = seen_by.find_first();
+        guards.reset(g);
+        reduction.forced.push_back(g);
+        reduction.forcing.push_back(i);
+        for (auto j = witnesses.find_first(); j != bitset::npos;
+             j = witnesses.find_next(j)) {
+            if (matrix[j][g])
+                witnesses.reset(j);
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+/// Clears the sets that are supersets of another kept set, of two equal sets
+/// the later one is cleared. Returns positions of the cleared sets.
+std::vector<std::size_t> dominated_supersets(const std::vector<bitset> &sets,
+                                             bool skip_empty) {
+    std::vector<bool> dropped(sets.size(), false);
+    std::vector<std::size_t> result;
+    for (std::size_t a = 0; a < sets.size(); ++a) {
+        if (dropped[a] || (skip_empty && sets[a].none()))
+            continue;
+        for (std::size_t b = 0; b < sets.size(); ++b) {
+            if (b == a || dropped[b] || !sets[a].is_subset_of(sets[b]))
+                continue;
+            if (b < a && sets[a] == sets[b])
+                continue;
+            dropped[b] = true;
+            result.push_back(b);
+        }
+    }
+    return result;
+}
+
+/// Drops the witnesses seen by a superset of the guards seeing another one.
+bool drop_dominated_witnesses(const coverage_matrix &matrix,
+                              bitset &witnesses, const bitset &guards) {
+    std::vector<std::size_t> kept;
+    std::vector<bitset> rows;
+    for (auto i = witnesses.find_first(); i != bitset::npos;
+         i = witnesses.find_next(i)) {
+        kept.push_back(i);
+        rows.push_back(matrix[i] & guards);
+    }
+    // a witness seen by no guard would dominate all the others
+    auto dropped = dominated_supersets(rows, true);
+    for (auto k : dropped)
+        witnesses.reset(kept[k]);
+    return !dropped.empty();
+}
+
+/// Drops the guards seeing a subset of the witnesses seen by another one.
+bool drop_dominated_guards(const coverage_matrix &matrix,
+                           const bitset &witnesses, bitset &guards) {
+    std::vector<std::size_t> kept;
+    std::vector<std::size_t> column(guards.size());
+    for (auto j = guards.find_first(); j != bitset::npos;
+         j = guards.find_next(j)) {
+        column[j] = kept.size();
+        kept.push_back(j);
+    }
+    // complements turn the subsets of seen witnesses into supersets
+    std::vector<bitset> unseen(kept.size(), witnesses);
+    for (auto i = witnesses.find_first(); i != bitset::npos;
+         i = witnesses.find_next(i)) {
+        bitset seen_by = matrix[i] & guards;
+        for (auto j = seen_by.find_first(); j != bitset::npos;
+             j = seen_by.find_next(j))
+            unseen[column[j]].reset(i);
+    }
+    auto dropped = dominated_supersets(unseen, false);
+    for (auto k : dropped)
+        guards.reset(kept[k]);
+    return !dropped.empty();
+}
+
+coverage_reduction reduce_coverage(const coverage_matrix &matrix,
+                                   std::size_t guard_count, double work_limit) {
+    coverage_reduction reduction;
+    reduction.witness_count = matrix.size();
+    reduction.guard_count = guard_count;
+    bitset witnesses(matrix.size()), guards(guard_count);
+    witnesses.set();
+    guards.set();
+
+    bool changed;
+    do {
+        changed = fix_forced_guards(matrix, witnesses, guards, reduction);
+        // a round of the dominance rules compares all pairs of witnesses and
+        // all pairs of guards, the forced guards are cheap and always fixed
+        double w = witnesses.count(), g = guards.count();
+        double work = (w + g) * w * g;
+        if (work > work_limit)
+            break;
+        work_limit -= work;
+        changed |= drop_dominated_witnesses(matrix, witnesses, guards);
+        changed |= drop_dominated_guards(matrix, witnesses, guards);
+    } while (changed);
+
+    for (auto j = guards.find_first(); j != bitset::npos;
+         j = guards.find_next(j))
+        reduction.guards.push_back(j);
+    for (auto i = witnesses.find_first(); i != bitset::npos;
+         i = witnesses.find_next(i)) {
+        reduction.witnesses.push_back(i);
+        bitset row(reduction.guards.size());
+        for (std::size_t k = 0; k < reduction.guards.size(); ++k)
+            row[k] = matrix[i][reduction.guards[k]];
+        reduction.matrix.push_back(std::move(row));
+    }
+    return reduction;
+}
+
+std::vector<int> expand_guards(const coverage_reduction &reduction,
+                               const std::vector<int> &chosen) {
+    std::vector<int> guards;
+    for (auto k : chosen)
+        guards.push_back(static_cast<int>(reduction.guards[k]));
+    for (auto g : reduction.forced)
+        guards.push_back(static_cast<int>(g));
+    return guards;
+}
+
+std::vector<double> expand_guard_values(const coverage_reduction &reduction,
+                                        const std::vector<double> &values) {
+    std::vector<double> expanded(reduction.guard_count, 0);
+    for (std::size_t k = 0; k < values.size(); ++k)
+        expanded[reduction.guards[k]] = values[k];
+    for (auto g : reduction.forced)
+        expanded[g] = 1;
+    return expanded;
+}
+
+std::vector<double> expand_witness_values(const coverage_reduction &reduction,
+                                          const std::vector<double> &values) {
+    std::vector<double> expanded(reduction.witness_count, 0);
+    for (std::size_t k = 0; k < values.size(); ++k)
+        expanded[reduction.witnesses[k]] = values[k];
+    for (auto w : reduction.forcing)
+        expanded[w] = 1;
+    return expanded;
+}
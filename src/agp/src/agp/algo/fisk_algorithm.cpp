@@ -1,5 +1,7 @@
 #include <agp/algo/fisk_algorithm.h>
+#include <agp/arrangement/star_shaped.h>
 #include <agp/plot/agp_plot.h>
+#include <agp/profile/profiler.h>
 
 #include <type_traits>
 
@@ -76,7 +78,15 @@ fisk_arrangement(const std::vector<Kernel::Point_2> &points) {
 
 std::vector<Kernel::Point_2>
 fisk_algorithm(const std::vector<Kernel::Point_2> &points) {
-    auto arr = fisk_arrangement(points);
+    AGP_PROFILE_SCOPE("fisk");
+    std::vector<Kernel::Point_2> single_guard;
+    if (star_shaped_solution(points, true, single_guard))
+        return single_guard;
+    Extended_Arrangement_2 arr;
+    {
+        AGP_PROFILE_SCOPE("triangulation");
+        arr = fisk_arrangement(points);
+    }
     std::vector<std::vector<Kernel::Point_2>> vertices = {
         std::vector<Kernel::Point_2>(), std::vector<Kernel::Point_2>(),
         std::vector<Kernel::Point_2>()};
@@ -1,4 +1,7 @@
 #include <agp/algo/ghosh_algorithm.h>
+#include <agp/arrangement/star_shaped.h>
+#include <agp/io/visibility_cache.h>
+#include <agp/profile/profiler.h>
 
 struct fan {
     unsigned long point_index;
@@ -8,21 +11,45 @@ struct fan {
     }
 };
 
-void create_fans(const std::set<Kernel::Point_2> &convex_components,
+bool create_fans(const std::set<Kernel::Point_2> &convex_components,
                  const std::vector<Arrangement_2> &visibility_regions,
-                 std::vector<fan> &fans);
+                 std::vector<fan> &fans,
+                 const std::function<bool()> &cancelled);
 
 std::vector<Kernel::Point_2>
 get_guards(const std::vector<unsigned long> &indices,
            const std::vector<Kernel::Point_2> &points);
 
 std::vector<Kernel::Point_2>
-ghosh_algorithm(const std::vector<Kernel::Point_2> &points) {
+ghosh_algorithm(const std::vector<Kernel::Point_2> &points,
+                std::vector<Arrangement_2> *guard_regions,
+                const std::function<bool()> &cancelled) {
+    AGP_PROFILE_SCOPE("ghosh");
+    auto stop = [&cancelled] { return cancelled && cancelled(); };
+    std::vector<Kernel::Point_2> single_guard;
+    if (star_shaped_solution(points, true, single_guard, guard_regions))
+        return single_guard;
     Arrangement_2 polygon = create_arrangement<Arrangement_2>(points);
-    std::vector<Arrangement_2> visibility_regions =
-        all_visibility_regions(polygon, points);
-    Arrangement_2 convex_components_arrangement =
-        overlay_arrangements<Arrangement_2>(polygon, visibility_regions);
+    std::vector<Arrangement_2> visibility_regions;
+    {
+        AGP_PROFILE_SCOPE("visibility");
+        visibility_regions = cached_visibility_regions(polygon, points);
+    }
+    if (stop())
+        return {};
+    // initialized by the lambda, assigning the overlay would copy it
+    Arrangement_2 convex_components_arrangement = [&] {
+        AGP_PROFILE_SCOPE("overlay");
+        return overlay_arrangements<Arrangement_2>(polygon, visibility_regions);
+    }();
+    AGP_PROFILE_COUNT("overlay_faces",
+                      convex_components_arrangement.number_of_faces());
+    AGP_PROFILE_MAX("overlay_vertices",
+                    convex_components_arrangement.number_of_vertices());
+    AGP_PROFILE_MAX("stored_region_vertices",
+                    total_vertices(visibility_regions));
+    if (stop())
+        return {};
     std::set<Kernel::Point_2> convex_components;
     std::vector<fan> fans;
     std::vector<unsigned long> approx_solution;
@@ -38,7 +65,8 @@ ghosh_algorithm(const std::vector<Kernel::Point_2> &points) {
 
     //    unsigned long n = points.size();
 
-    create_fans(convex_components, visibility_regions, fans);
+    if (!create_fans(convex_components, visibility_regions, fans, stop))
+        return {};
 
     //    for (unsigned long i = 0; i < n; ++i) {
     //        std::set<Kernel::Point_2> visible_components;
@@ -69,14 +97,23 @@ ghosh_algorithm(const std::vector<Kernel::Point_2> &points) {
     //    }
 
     //     std::cout << solution.size() << " ";
+    if (guard_regions) {
+        for (const auto &i : approx_solution)
+            guard_regions->push_back(visibility_regions[i]);
+    }
     return get_guards(approx_solution, points); // solution;
 }
 
-void create_fans(const std::set<Kernel::Point_2> &convex_components,
+/// Builds the fan of every vertex, returns false if cancelled.
+bool create_fans(const std::set<Kernel::Point_2> &convex_components,
                  const std::vector<Arrangement_2> &visibility_regions,
-                 std::vector<fan> &fans) {
+                 std::vector<fan> &fans,
+                 const std::function<bool()> &cancelled) {
+    AGP_PROFILE_SCOPE("fans");
     unsigned long n = visibility_regions.size();
     for (unsigned long i = 0; i < n; ++i) {
+        if (cancelled())
+            return false;
         std::set<Kernel::Point_2> visible_components;
         for (const auto &convex_component : convex_components) {
             if (point_visible(visibility_regions[i], convex_component))
@@ -84,6 +121,7 @@ void create_fans(const std::set<Kernel::Point_2> &convex_components,
         }
         fans.push_back({i, visible_components});
     }
+    return true;
 }
 
 std::vector<Kernel::Point_2>
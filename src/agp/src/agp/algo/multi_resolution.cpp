@@ -0,0 +1,84 @@
+#include <agp/algo/baumgartner_algorithm.h>
+#include <agp/algo/couto_algorithm.h>
+#include <agp/algo/multi_resolution.h>
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/simplification.h>
+#include <agp/discretization_methods.h>
+#include <agp/initial_placements.h>
+#include <agp/profile/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+using vec_t = std::vector<Kernel::Point_2>;
+
+vec_t multi_resolution_algorithm(const vec_t &points,
+                                 const multi_resolution_options &options) {
+    AGP_PROFILE_SCOPE("multi_resolution");
+    auto start = std::chrono::steady_clock::now();
+    auto coarse = simplify_polygon(points, options.tolerance);
+    AGP_PROFILE_COUNT("coarse_vertices", coarse.size());
+
+    // Both solves report to the callback as one run. The bounds and guards of
+    // the coarse gallery say nothing about the full one, so meanwhile only
+    // its trivial bounds are reported.
+    unsigned long coarse_iterations = 0;
+    unsigned long upper_bound = guard_upper_bound(points);
+    bool stopped = false;
+    auto report = [&](const iteration_progress &solve, bool full) {
+        iteration_progress state = solve;
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        state.elapsed = elapsed.count();
+        if (full) {
+            state.iteration += coarse_iterations;
+        } else {
+            coarse_iterations = solve.iteration;
+            state.lower_bound = 0;
+            state.upper_bound = upper_bound;
+            state.incumbent.clear();
+        }
+        // a stopped coarse solve stops the full one after its first
+        // iteration
+        bool go = options.progress(state);
+        if (!full && !go)
+            stopped = true;
+        return go && !stopped;
+    };
+    progress_callback coarse_progress, full_progress;
+    if (options.progress) {
+        coarse_progress = [&report](const iteration_progress &solve) {
+            return report(solve, false);
+        };
+        full_progress = [&report](const iteration_progress &solve) {
+            return report(solve, true);
+        };
+    }
+
+    // Baumgartner's algorithm measures its limit in processor time.
+    std::clock_t begin = std::clock();
+    vec_t coarse_guards;
+    if (coarse.size() < points.size()) {
+        AGP_PROFILE_SCOPE("coarse");
+        coarse_guards =
+            options.vertex_guards
+                ? couto_algorithm(coarse, all_vertices, 0, nullptr, nullptr,
+                                  coarse_progress)
+                : baumgartner_algorithm(coarse, every_second, options.sec, 0,
+                                        nullptr, nullptr, coarse_progress);
+    }
+    AGP_PROFILE_COUNT("coarse_guards", coarse_guards.size());
+
+    // The vertices of the coarse gallery are vertices of the full one, so
+    // Couto's guards of the coarse gallery are a valid start of its IPs.
+    if (options.vertex_guards)
+        return couto_algorithm(points, all_vertices, 0, nullptr, nullptr,
+                               full_progress, coarse_guards);
+    int spent = static_cast<int>(double(std::clock() - begin) /
+                                 CLOCKS_PER_SEC);
+    return baumgartner_algorithm(points,
+                                 with_guards(every_second, coarse_guards),
+                                 std::max(options.sec - spent, 0), 0,
+                                 nullptr, nullptr, full_progress);
+}
@@ -0,0 +1,221 @@
+#include <agp/algo/baumgartner_algorithm.h>
+#include <agp/algo/couto_algorithm.h>
+#include <agp/algo/fisk_algorithm.h>
+#include <agp/algo/ghosh_algorithm.h>
+#include <agp/algo/portfolio.h>
+#include <agp/arrangement/compaction.h>
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/star_shaped.h>
+#include <agp/discretization_methods.h>
+#include <agp/initial_placements.h>
+#include <agp/parallel/thread_pool.h>
+#include <agp/profile/profiler.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+/// Bounds and the best solution shared by the algorithms of a race. Stored
+/// solutions are detached copies, so their points are touched only under the
+/// mutex.
+class race {
+  public:
+    race(const std::vector<Kernel::Point_2> &vertices,
+         const portfolio_options &options)
+        : options_(options), start_(std::chrono::steady_clock::now()),
+          trivial_bound_(guard_upper_bound(vertices)) {
+        best_.lower_bound = vertices.empty() ? 0 : 1;
+        best_.optimal = false;
+    }
+
+    bool stopped() {
+        if (options_.time_limit > 0 && elapsed() > options_.time_limit)
+            stopped_ = true;
+        return stopped_;
+    }
+
+    /// Offers a solution covering the gallery. Solutions found after the end
+    /// of the race are ignored, so the result doesn't change once returned.
+    void solution(const std::vector<Kernel::Point_2> &guards,
+                  const std::string &algorithm) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_)
+            return;
+        offer(guards, algorithm);
+        check();
+    }
+
+    /// Passes an iteration of an exact algorithm to the race, its bound and
+    /// incumbent are used if they are valid for the solved variant. Returns
+    /// false if the algorithm should stop.
+    bool report(const iteration_progress &state, const std::string &algorithm,
+                bool bound_valid, bool solution_valid) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_)
+            return false;
+        if (solution_valid && !state.incumbent.empty())
+            offer(state.incumbent, algorithm);
+        if (bound_valid && state.lower_bound > best_.lower_bound)
+            best_.lower_bound = state.lower_bound;
+        ++iterations_;
+        check();
+
+        if (options_.progress && !stopped_) {
+            iteration_progress shared = state;
+            shared.iteration = iterations_;
+            shared.elapsed = elapsed();
+            shared.lower_bound = best_.lower_bound;
+            shared.upper_bound = solved_ ? best_.guards.size() : trivial_bound_;
+            shared.incumbent = best_.guards;
+            if (!options_.progress(shared))
+                stopped_ = true;
+        }
+
+        // An algorithm whose lower bound reaches the best solution cannot
+        // improve it.
+        return !stopped_ &&
+               !(solved_ && state.lower_bound >= best_.guards.size());
+    }
+
+    /// @return size of the best solution, 0 if there is none yet
+    unsigned long best_size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return solved_ ? best_.guards.size() : 0;
+    }
+
+    portfolio_result result() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return best_;
+    }
+
+  private:
+    double elapsed() const {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+        return elapsed.count();
+    }
+
+    void offer(const std::vector<Kernel::Point_2> &guards,
+               const std::string &algorithm) {
+        if (solved_ && guards.size() >= best_.guards.size())
+            return;
+        best_.guards = detached_copy(guards);
+        best_.algorithm = algorithm;
+        solved_ = true;
+    }
+
+    void check() {
+        if (solved_ && best_.lower_bound >= best_.guards.size()) {
+            best_.optimal = true;
+            stopped_ = true;
+        }
+        stopped();
+    }
+
+    const portfolio_options options_;
+    std::chrono::steady_clock::time_point start_;
+    unsigned long trivial_bound_;
+    std::mutex mutex_;
+    std::atomic<bool> stopped_{false};
+    portfolio_result best_;
+    bool solved_ = false;
+    unsigned long iterations_ = 0;
+};
+
+portfolio_result
+portfolio_algorithm(const std::vector<Kernel::Point_2> &vertices,
+                    const portfolio_options &options) {
+    AGP_PROFILE_SCOPE("portfolio");
+    // a star-shaped gallery needs no race, one guard is optimal
+    portfolio_result single;
+    if (star_shaped_solution(vertices, options.vertex_guards, single.guards)) {
+        single.algorithm = "kernel";
+        single.lower_bound = 1;
+        single.optimal = true;
+        return single;
+    }
+    auto state = std::make_shared<race>(vertices, options);
+    bool vertex_guards = options.vertex_guards;
+    auto &pool = default_thread_pool();
+    std::vector<std::future<void>> heuristics, exact;
+
+    // The heuristics go first, so that the exact algorithms get an upper
+    // bound early even if the pool runs the tasks one after another.
+    heuristics.push_back(
+        pool.submit([state, points = detached_copy(vertices)] {
+            if (!state->stopped())
+                state->solution(fisk_algorithm(points), "fisk");
+        }));
+    heuristics.push_back(
+        pool.submit([state, points = detached_copy(vertices)] {
+            if (state->stopped())
+                return;
+            auto guards = ghosh_algorithm(
+                points, nullptr, [&state] { return state->stopped(); });
+            if (!guards.empty())
+                state->solution(guards, "ghosh");
+        }));
+    exact.push_back(pool.submit([state, vertex_guards,
+                                 points = detached_copy(vertices)] {
+        if (state->stopped())
+            return;
+        // CPLEX discards IP solutions that aren't smaller than the best one
+        auto guards = couto_algorithm(
+            points, all_vertices, 0, nullptr, nullptr,
+            [&state, vertex_guards](const iteration_progress &p) {
+                return state->report(p, "couto", vertex_guards, true);
+            },
+            {}, [&state] { return state->best_size(); });
+        if (!guards.empty())
+            state->solution(guards, "couto");
+    }));
+    exact.push_back(pool.submit([state, vertex_guards,
+                                 points = detached_copy(vertices)] {
+        if (state->stopped())
+            return;
+        // The race has its own wall time limit, Baumgartner's one counts the
+        // processor time of all threads.
+        auto guards = baumgartner_algorithm(
+            points, every_second, std::numeric_limits<int>::max(), 0,
+            nullptr, nullptr,
+            [&state, vertex_guards](const iteration_progress &p) {
+                return state->report(p, "baumgartner", true, !vertex_guards);
+            });
+        if (!vertex_guards && !guards.empty())
+            state->solution(guards, "baumgartner");
+    }));
+
+    // The exact algorithms stop after their current iteration and Ghosh's
+    // algorithm after its current phase, the race returns once all of them
+    // have. A worker of the pool runs the race's own pending tasks while
+    // waiting, so that a race started from a task never waits for itself.
+    auto finish = [&](std::future<void> &run) {
+        while (run.wait_for(std::chrono::milliseconds(10)) !=
+               std::future_status::ready) {
+            if (pool.is_worker())
+                pool.run_pending_task();
+        }
+        run.get();
+    };
+
+    // A failing algorithm doesn't stop the others, its error is passed on
+    // only if no solution was found.
+    std::exception_ptr error;
+    for (auto *runs : {&exact, &heuristics}) {
+        for (auto &run : *runs) {
+            try {
+                finish(run);
+            } catch (...) {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    }
+    auto result = state->result();
+    if (result.guards.empty() && error)
+        std::rethrow_exception(error);
+    return result;
+}
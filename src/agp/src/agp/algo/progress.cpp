@@ -0,0 +1,14 @@
+#include <agp/algo/progress.h>
+#include <agp/profile/memory.h>
+
+progress_callback memory_budget(std::size_t bytes, progress_callback next,
+                                bool *exceeded) {
+    return [bytes, next, exceeded](const iteration_progress &state) {
+        if (resident_memory() > bytes) {
+            if (exceeded)
+                *exceeded = true;
+            return false;
+        }
+        return !next || next(state);
+    };
+}
@@ -0,0 +1,148 @@
+#include <agp/algo/baumgartner_algorithm.h>
+#include <agp/algo/couto_algorithm.h>
+#include <agp/algo/fisk_algorithm.h>
+#include <agp/algo/ghosh_algorithm.h>
+#include <agp/algo/portfolio.h>
+#include <agp/algo/solve_async.h>
+#include <agp/arrangement/compaction.h>
+#include <agp/discretization_methods.h>
+#include <agp/initial_placements.h>
+#include <agp/parallel/thread_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+/// State of a job shared by the handle and the task. The stored incumbent is
+/// a detached copy and its points are touched only under the mutex, since
+/// lazy points can't be shared between threads.
+struct solve_handle::shared_state {
+    solve_options options;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    std::atomic<bool> cancelled{false};
+    mutable std::mutex mutex;
+    iteration_progress last{};
+
+    /// Progress callback passed to the algorithms.
+    bool update(const iteration_progress &state) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        bool go = !cancelled && !(options.time_limit > 0 &&
+                                  elapsed.count() > options.time_limit);
+        if (go && options.progress)
+            go = options.progress(state);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        last.iteration = state.iteration;
+        last.elapsed = state.elapsed;
+        last.lower_bound = state.lower_bound;
+        last.upper_bound = state.upper_bound;
+        last.guards = state.guards;
+        last.witnesses = state.witnesses;
+        last.incumbent = detached_copy(state.incumbent);
+        return go;
+    }
+};
+
+std::vector<Kernel::Point_2>
+run_algorithm(agp_algorithm algorithm,
+              const std::vector<Kernel::Point_2> &points,
+              const solve_options &options,
+              const progress_callback &progress) {
+    switch (algorithm) {
+    case agp_algorithm::fisk:
+        return fisk_algorithm(points);
+    case agp_algorithm::ghosh:
+        return ghosh_algorithm(points);
+    case agp_algorithm::couto:
+        return couto_algorithm(points, all_vertices,
+                               options.compaction_interval, nullptr, nullptr,
+                               progress);
+    case agp_algorithm::baumgartner:
+        // The time limit is checked in the progress callback, Baumgartner's
+        // own one counts the processor time of all threads.
+        return baumgartner_algorithm(points, every_second,
+                                     std::numeric_limits<int>::max(),
+                                     options.compaction_interval, nullptr,
+                                     nullptr, progress);
+    case agp_algorithm::portfolio: {
+        portfolio_options portfolio;
+        portfolio.vertex_guards = options.vertex_guards;
+        portfolio.time_limit = options.time_limit;
+        portfolio.progress = progress;
+        return portfolio_algorithm(points, portfolio).guards;
+    }
+    }
+    throw std::invalid_argument("unknown algorithm");
+}
+
+bool solve_handle::valid() const { return result_.valid(); }
+
+bool solve_handle::ready() const {
+    return valid() && result_.wait_for(std::chrono::seconds(0)) ==
+                          std::future_status::ready;
+}
+
+std::vector<Kernel::Point_2> solve_handle::get() {
+    if (!valid())
+        throw std::logic_error("solve_handle has no job to wait for");
+    // A worker of the pool runs the tasks it submitted while waiting, the job
+    // itself if it is still queued, so that a job waited for from the task
+    // that started it never blocks the pool.
+    auto &pool = default_thread_pool();
+    if (pool.is_worker())
+        return pool.wait(result_);
+    return result_.get();
+}
+
+void solve_handle::cancel() {
+    if (state_)
+        state_->cancelled = true;
+}
+
+bool solve_handle::cancelled() const { return state_ && state_->cancelled; }
+
+iteration_progress solve_handle::progress() const {
+    if (!state_)
+        return {};
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    const auto &last = state_->last;
+    iteration_progress copy{};
+    copy.iteration = last.iteration;
+    copy.elapsed = last.elapsed;
+    copy.lower_bound = last.lower_bound;
+    copy.upper_bound = last.upper_bound;
+    copy.guards = last.guards;
+    copy.witnesses = last.witnesses;
+    copy.incumbent = detached_copy(last.incumbent);
+    return copy;
+}
+
+std::vector<Kernel::Point_2> solve_handle::partial_result() const {
+    if (!state_)
+        return {};
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return detached_copy(state_->last.incumbent);
+}
+
+solve_handle solve_async(const std::vector<Kernel::Point_2> &vertices,
+                         agp_algorithm algorithm,
+                         const solve_options &options) {
+    solve_handle handle;
+    handle.state_ = std::make_shared<solve_handle::shared_state>();
+    handle.state_->options = options;
+    handle.result_ = default_thread_pool().submit(
+        [state = handle.state_, algorithm,
+         points = detached_copy(vertices)]() -> std::vector<Kernel::Point_2> {
+            if (state->cancelled)
+                return {};
+            return run_algorithm(algorithm, points, state->options,
+                                 [&state](const iteration_progress &p) {
+                                     return state->update(p);
+                                 });
+        });
+    return handle;
+}
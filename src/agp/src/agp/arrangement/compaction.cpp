@@ -0,0 +1,76 @@
+#include <agp/arrangement/compaction.h>
+#include <agp/profile/profiler.h>
+
+/// Counts lazy objects whose exact value is computed now, an object whose
+/// exact value an earlier pass or predicate already computed only returns it.
+template <typename T> static void count_exact_evaluation(const T &object) {
+    AGP_PROFILE_COUNT("exact_evaluations", object.ptr()->is_lazy() ? 1 : 0);
+}
+
+void exactify(const Kernel::Point_2 &point) {
+    AGP_PROFILE_COUNT("exactify_calls", 1);
+    count_exact_evaluation(point);
+    CGAL::exact(point);
+}
+
+void exactify(const std::vector<Kernel::Point_2> &points) {
+    for (const auto &p : points) {
+        exactify(p);
+    }
+}
+
+void exactify(const Arrangement_2 &arr) {
+    for (auto v = arr.vertices_begin(); v != arr.vertices_end(); ++v) {
+        exactify(v->point());
+    }
+    for (auto e = arr.edges_begin(); e != arr.edges_end(); ++e) {
+        count_exact_evaluation(e->curve().line());
+        CGAL::exact(e->curve().line());
+        exactify(e->curve().source());
+        exactify(e->curve().target());
+    }
+}
+
+void exactify(const std::vector<Arrangement_2> &arrangements) {
+    for (const auto &arr : arrangements) {
+        exactify(arr);
+    }
+}
+
+void exactify(const std::vector<region_handle> &regions) {
+    for (const auto &region : regions) {
+        exactify(*region);
+    }
+}
+
+void exactify(const std::vector<Polygon_2> &polygons) {
+    for (const auto &polygon : polygons) {
+        for (auto v = polygon.vertices_begin(); v != polygon.vertices_end();
+             ++v) {
+            exactify(*v);
+        }
+    }
+}
+
+Kernel::Point_2 detached_copy(const Kernel::Point_2 &point) {
+    return Kernel::Point_2(Kernel::FT(CGAL::exact(point.x())),
+                           Kernel::FT(CGAL::exact(point.y())));
+}
+
+std::vector<Kernel::Point_2>
+detached_copy(const std::vector<Kernel::Point_2> &points) {
+    std::vector<Kernel::Point_2> copies;
+    copies.reserve(points.size());
+    for (const auto &p : points) {
+        copies.push_back(detached_copy(p));
+    }
+    return copies;
+}
+
+void record_compaction(std::size_t heap_before, compaction_stats *stats) {
+    if (!stats)
+        return;
+    ++stats->passes;
+    stats->freed_bytes += static_cast<long long>(heap_before) -
+                          static_cast<long long>(heap_in_use());
+}
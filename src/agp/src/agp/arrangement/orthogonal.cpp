@@ -0,0 +1,108 @@
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/visibility.h>
+
+#include <algorithm>
+
+using vec_t = std::vector<Kernel::Point_2>;
+
+bool is_orthogonal(const vec_t &vertices) {
+    if (vertices.size() < 4)
+        return false;
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        const auto &p = vertices[i];
+        const auto &q = vertices[(i + 1) % vertices.size()];
+        if (p.x() != q.x() && p.y() != q.y())
+            return false;
+    }
+    return true;
+}
+
+unsigned long guard_upper_bound(const vec_t &vertices) {
+    return vertices.size() / (is_orthogonal(vertices) ? 4 : 3);
+}
+
+/// Sorted distinct values of the coordinates.
+std::vector<Kernel::FT> distinct(std::vector<Kernel::FT> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+std::size_t grid_cell_bound(const vec_t &vertices) {
+    std::vector<Kernel::FT> x, y;
+    for (const auto &p : vertices) {
+        x.push_back(p.x());
+        y.push_back(p.y());
+    }
+    std::size_t columns = distinct(std::move(x)).size();
+    std::size_t rows = distinct(std::move(y)).size();
+    if (columns < 2 || rows < 2)
+        return 0;
+    return (columns - 1) * (rows - 1);
+}
+
+std::vector<grid_cell> orthogonal_cells(const vec_t &vertices) {
+    struct vertical_edge {
+        Kernel::FT x, low, high;
+    };
+    std::vector<Kernel::FT> x, y;
+    std::vector<vertical_edge> edges;
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        const auto &p = vertices[i];
+        const auto &q = vertices[(i + 1) % vertices.size()];
+        x.push_back(p.x());
+        y.push_back(p.y());
+        if (p.x() == q.x() && p.y() != q.y())
+            edges.push_back({p.x(), std::min(p.y(), q.y()),
+                             std::max(p.y(), q.y())});
+    }
+    x = distinct(std::move(x));
+    y = distinct(std::move(y));
+
+    std::vector<grid_cell> cells;
+    for (std::size_t row = 0; row + 1 < y.size(); ++row) {
+        // edges crossing the row alternately enter and leave the polygon
+        std::vector<Kernel::FT> crossings;
+        for (const auto &e : edges)
+            if (e.low <= y[row] && y[row + 1] <= e.high)
+                crossings.push_back(e.x);
+        std::sort(crossings.begin(), crossings.end());
+        for (std::size_t k = 0; k + 1 < crossings.size(); k += 2) {
+            auto column =
+                std::lower_bound(x.begin(), x.end(), crossings[k]) - x.begin();
+            for (; x[column] < crossings[k + 1]; ++column)
+                cells.push_back({Kernel::Point_2(x[column], y[row]),
+                                 Kernel::Point_2(x[column + 1], y[row + 1])});
+        }
+    }
+    return cells;
+}
+
+bool cells_seen(const std::vector<grid_cell> &cells,
+                const std::vector<Arrangement_2> &visibility_regions,
+                const std::vector<int> &guards) {
+    // neighbouring cells are usually seen by the same guard, so the guard of
+    // the previous cell is tried first
+    std::size_t last = 0;
+    for (const auto &cell : cells) {
+        const Kernel::Point_2 corners[] = {
+            cell.lower_left,
+            Kernel::Point_2(cell.upper_right.x(), cell.lower_left.y()),
+            cell.upper_right,
+            Kernel::Point_2(cell.lower_left.x(), cell.upper_right.y())};
+        bool seen = false;
+        for (std::size_t k = 0; k < guards.size() && !seen; ++k) {
+            std::size_t i = (last + k) % guards.size();
+            const auto &region = visibility_regions[guards[i]];
+            seen = std::all_of(std::begin(corners), std::end(corners),
+                               [&region](const Kernel::Point_2 &corner) {
+                                   return point_visible(region, corner);
+                               });
+            if (seen)
+                last = i;
+        }
+        if (!seen)
+            return false;
+    }
+    return true;
+}
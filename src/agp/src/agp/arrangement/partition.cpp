@@ -2,6 +2,14 @@
 
 #include <agp/plot/agp_plot.h>
 
+#include <CGAL/Fraction_traits.h>
+#include <boost/optional.hpp>
+
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 void kernel_points_to_trait_points(
     const std::vector<Kernel::Point_2> &points,
     std::vector<Partition_Traits::Point_2> &ret) {
@@ -10,8 +18,9 @@ void kernel_points_to_trait_points(
     }
 }
 
-void to_convex_components(const std::vector<Kernel::Point_2> &k_points,
-                          std::list<Partition_Polygon_2> &partition_polys) {
+template <typename Polygon_list>
+void partition_convex(const std::vector<Kernel::Point_2> &k_points,
+                      Polygon_list &partition_polys) {
     Partition_Traits partition_traits;
     std::vector<Partition_Traits::Point_2> points;
     kernel_points_to_trait_points(k_points, points);
@@ -21,25 +30,167 @@ void to_convex_components(const std::vector<Kernel::Point_2> &k_points,
         v_begin, v_end, std::back_inserter(partition_polys), partition_traits);
 }
 
+void to_convex_components(const std::vector<Kernel::Point_2> &k_points,
+                          std::list<Partition_Polygon_2> &partition_polys) {
+    partition_convex(k_points, partition_polys);
+}
+
+void to_convex_components(const std::vector<Kernel::Point_2> &k_points,
+                          arena_list<Partition_Polygon_2> &partition_polys) {
+    partition_convex(k_points, partition_polys);
+}
+
+using Exact_FT = Kernel::FT::ET;
+using Exact_RT = CGAL::Fraction_traits<Exact_FT>::Numerator_type;
+
+Exact_RT floor_rational(const Exact_FT &q) {
+    Exact_RT num, den;
+    CGAL::Fraction_traits<Exact_FT>::Decompose()(q, num, den);
+    Exact_RT f = num / den;
+    // integer division truncates towards zero
+    if (f * den > num)
+        f = f - 1;
+    return f;
+}
+
+Kernel::FT simplest_rational(const Kernel::FT &lower, const Kernel::FT &upper) {
+    Exact_FT a = CGAL::exact(lower), b = CGAL::exact(upper);
+    if (a < 0 && b > 0)
+        return Kernel::FT(0);
+
+    // Continued fraction of the result: x = t0 + 1 / (t1 + 1 / (t2 + ...)).
+    std::vector<Exact_RT> terms;
+    bool bounded = true;
+    while (true) {
+        Exact_RT fl = floor_rational(a);
+        if (!bounded || Exact_FT(fl + 1) < b) {
+            terms.push_back(fl + 1);
+            break;
+        }
+        // fl <= a < b <= fl + 1, so x = fl + 1 / y with y in (1/(b-fl),
+        // 1/(a-fl))
+        terms.push_back(fl);
+        Exact_FT da = a - Exact_FT(fl), db = b - Exact_FT(fl);
+        a = Exact_FT(1) / db;
+        if (da == 0)
+            bounded = false;
+        else
+            b = Exact_FT(1) / da;
+    }
+
+    Exact_FT x(terms.back());
+    for (auto t = std::next(terms.rbegin()); t != terms.rend(); ++t) {
+        x = Exact_FT(*t) + Exact_FT(1) / x;
+    }
+    return Kernel::FT(x);
+}
+
+Kernel::Point_2
+small_interior_point(const std::vector<Kernel::Point_2> &convex) {
+    Kernel::FT x_min = convex[0].x(), x_max = convex[0].x();
+    for (const auto &p : convex) {
+        if (p.x() < x_min)
+            x_min = p.x();
+        if (p.x() > x_max)
+            x_max = p.x();
+    }
+    if (x_min == x_max)
+        return CGAL::centroid(convex.begin(), convex.end());
+
+    Kernel::FT x_margin = (x_max - x_min) / 4;
+    Kernel::FT x = simplest_rational(x_min + x_margin, x_max - x_margin);
+
+    bool slice_found = false;
+    Kernel::FT y_min, y_max;
+    for (unsigned i = 0; i < convex.size(); ++i) {
+        const auto &s = convex[i], &t = convex[(i + 1) % convex.size()];
+        if (s.x() == t.x() || (x < s.x() && x < t.x()) ||
+            (x > s.x() && x > t.x()))
+            continue;
+        Kernel::FT y = s.y() + (x - s.x()) * (t.y() - s.y()) / (t.x() - s.x());
+        if (!slice_found || y < y_min)
+            y_min = y;
+        if (!slice_found || y > y_max)
+            y_max = y;
+        slice_found = true;
+    }
+    if (!slice_found || y_min == y_max)
+        return CGAL::centroid(convex.begin(), convex.end());
+
+    Kernel::FT y_margin = (y_max - y_min) / 4;
+    Kernel::FT y = simplest_rational(y_min + y_margin, y_max - y_margin);
+    return Kernel::Point_2(x, y);
+}
+
 std::list<Kernel::Point_2>
 discretize_reflex(const std::vector<Kernel::Point_2> &v) {
     std::list<Kernel::Point_2> points;
-    std::list<Partition_Polygon_2> partition_polys;
+    arena_list<Partition_Polygon_2> partition_polys;
     to_convex_components(v, partition_polys);
     for (const auto &pol : partition_polys) {
-        auto c = CGAL::centroid(pol.vertices_begin(), pol.vertices_end());
-        points.push_back(Kernel::Point_2(c.x(), c.y()));
+        std::vector<Kernel::Point_2> piece;
+        for (auto it = pol.vertices_begin(); it != pol.vertices_end(); ++it) {
+            piece.push_back(Kernel::Point_2(it->x(), it->y()));
+        }
+        points.push_back(small_interior_point(piece));
     }
     return points;
 }
 
-std::list<Kernel::Point_2> arr_discretization(const Arrangement_2 &arr) {
-    std::list<Kernel::Point_2> points;
-    for (auto f = arr.faces_begin(); f != arr.faces_end(); ++f) {
-        if (f->is_unbounded())
+/// Point where the ray from a vertex of the polygon first hits the boundary
+/// again, none if the ray leaves the polygon without hitting it.
+boost::optional<Kernel::Point_2>
+ray_hit(const std::vector<Kernel::Point_2> &points, std::size_t vertex,
+        const Kernel::Vector_2 &direction) {
+    const auto &origin = points[vertex];
+    Kernel::Ray_2 ray(origin, direction);
+    std::size_t n = points.size();
+    boost::optional<Kernel::Point_2> hit;
+    for (std::size_t i = 0; i < n; ++i) {
+        // the edges at the vertex only touch the ray at its origin
+        if (i == vertex || (i + 1) % n == vertex)
             continue;
-        auto to_add = discretize_reflex(face_vertices(f));
-        points.insert(points.end(), to_add.begin(), to_add.end());
+        Kernel::Segment_2 edge(points[i], points[(i + 1) % n]);
+        auto result = CGAL::intersection(ray, edge);
+        if (!result)
+            continue;
+        Kernel::Point_2 p;
+        if (auto point = boost::get<Kernel::Point_2>(&*result))
+            p = *point;
+        else {
+            auto segment = boost::get<Kernel::Segment_2>(&*result);
+            p = CGAL::has_smaller_distance_to_point(
+                    origin, segment->source(), segment->target())
+                    ? segment->source()
+                    : segment->target();
+        }
+        if (!hit || CGAL::has_smaller_distance_to_point(origin, p, *hit))
+            hit = p;
     }
-    return points;
+    return hit;
+}
+
+std::vector<Kernel::Segment_2>
+extension_chords(const std::vector<Kernel::Point_2> &v) {
+    std::vector<Kernel::Segment_2> chords;
+    std::set<std::pair<Kernel::Point_2, Kernel::Point_2>> known;
+    std::size_t n = v.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto &previous = v[(i + n - 1) % n], &next = v[(i + 1) % n];
+        if (CGAL::orientation(previous, v[i], next) != CGAL::RIGHT_TURN)
+            continue;
+        for (const auto &direction : {v[i] - previous, v[i] - next}) {
+            // an edge extended from a reflex vertex of a counterclockwise
+            // simple polygon always runs into the interior and hits the
+            // boundary
+            auto hit = ray_hit(v, i, direction);
+            if (!hit)
+                throw std::invalid_argument(
+                    "extension_chords needs a counterclockwise simple polygon");
+            // the chord between two reflex vertices extends the edges of both
+            if (known.insert(std::minmax(v[i], *hit)).second)
+                chords.emplace_back(v[i], *hit);
+        }
+    }
+    return chords;
 }
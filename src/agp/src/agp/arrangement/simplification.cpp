@@ -0,0 +1,78 @@
+#include <agp/arrangement/simplification.h>
+#include <agp/profile/profiler.h>
+
+using vec_t = std::vector<Kernel::Point_2>;
+
+/// Checks whether a point lies in the closed triangle, which may be
+/// degenerate.
+bool in_closed_triangle(const Kernel::Point_2 &a, const Kernel::Point_2 &b,
+                        const Kernel::Point_2 &c, const Kernel::Point_2 &p) {
+    auto orientation = CGAL::orientation(a, b, c);
+    if (orientation == CGAL::COLLINEAR)
+        return Kernel::Segment_2(a, b).has_on(p) ||
+               Kernel::Segment_2(b, c).has_on(p) ||
+               Kernel::Segment_2(a, c).has_on(p);
+    auto opposite = orientation == CGAL::LEFT_TURN ? CGAL::RIGHT_TURN
+                                                   : CGAL::LEFT_TURN;
+    return CGAL::orientation(a, b, p) != opposite &&
+           CGAL::orientation(b, c, p) != opposite &&
+           CGAL::orientation(c, a, p) != opposite;
+}
+
+/// Checks whether the original vertices strictly between positions first and
+/// last, the ones the edge replaces, lie within the distance of the edge.
+bool run_within(const vec_t &vertices, std::size_t first, std::size_t last,
+                const Kernel::Segment_2 &edge,
+                const Kernel::FT &squared_tolerance) {
+    for (auto j = (first + 1) % vertices.size(); j != last;
+         j = (j + 1) % vertices.size())
+        if (CGAL::squared_distance(vertices[j], edge) > squared_tolerance)
+            return false;
+    return true;
+}
+
+vec_t simplify_polygon(const vec_t &vertices, const Kernel::FT &tolerance) {
+    AGP_PROFILE_SCOPE("simplification");
+    std::size_t n = vertices.size(), remaining = n;
+    std::vector<std::size_t> previous(n), next(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        previous[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+    std::vector<bool> removed(n, false);
+    Kernel::FT squared_tolerance = tolerance * tolerance;
+
+    // the vertex of the new edge may make its neighbours removable, so the
+    // outline is scanned until a pass removes nothing
+    bool changed = true;
+    while (changed && remaining > 3) {
+        changed = false;
+        for (std::size_t i = 0; i < n && remaining > 3; ++i) {
+            if (removed[i])
+                continue;
+            const auto &p = vertices[previous[i]], &q = vertices[next[i]];
+            if (!run_within(vertices, previous[i], next[i],
+                            Kernel::Segment_2(p, q), squared_tolerance))
+                continue;
+            bool blocked = false;
+            for (auto j = next[next[i]]; j != previous[i] && !blocked;
+                 j = next[j])
+                blocked = in_closed_triangle(p, vertices[i], q, vertices[j]);
+            if (blocked)
+                continue;
+            removed[i] = true;
+            next[previous[i]] = next[i];
+            previous[next[i]] = previous[i];
+            --remaining;
+            changed = true;
+        }
+    }
+
+    vec_t simplified;
+    simplified.reserve(remaining);
+    for (std::size_t i = 0; i < n; ++i)
+        if (!removed[i])
+            simplified.push_back(vertices[i]);
+    AGP_PROFILE_COUNT("removed_vertices", n - remaining);
+    return simplified;
+}
@@ -0,0 +1,185 @@
+#include <agp/arrangement/star_shaped.h>
+#include <agp/profile/profiler.h>
+
+#include <CGAL/Polygon_2_algorithms.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+using vec_t = std::vector<Kernel::Point_2>;
+
+/// Lower left and upper right corners of the bounding box of the points.
+std::pair<Kernel::Point_2, Kernel::Point_2>
+bounding_corners(const vec_t &points) {
+    auto x = std::minmax_element(
+        points.begin(), points.end(),
+        [](const auto &p, const auto &q) { return p.x() < q.x(); });
+    auto y = std::minmax_element(
+        points.begin(), points.end(),
+        [](const auto &p, const auto &q) { return p.y() < q.y(); });
+    return {Kernel::Point_2(x.first->x(), y.first->y()),
+            Kernel::Point_2(x.second->x(), y.second->y())};
+}
+
+/// Checks whether a point lies in a convex polygon, which may be degenerate.
+bool in_convex(const vec_t &convex, const Kernel::Point_2 &point) {
+    for (std::size_t i = 0; i < convex.size(); ++i) {
+        if (CGAL::orientation(convex[i], convex[(i + 1) % convex.size()],
+                              point) == CGAL::RIGHT_TURN)
+            return false;
+    }
+    // all the orientations are collinear for a segment or a single point
+    auto box = bounding_corners(convex);
+    return box.first.x() <= point.x() && point.x() <= box.second.x() &&
+           box.first.y() <= point.y() && point.y() <= box.second.y();
+}
+
+/// Inner half-planes of the edges of a counterclockwise polygon and of the
+/// sides of its bounding box, as lines with the half-plane on their left,
+/// sorted by direction. Of lines with the same direction only the innermost
+/// one is kept.
+std::vector<Kernel::Line_2> sorted_half_planes(const vec_t &polygon) {
+    // the kernel lies in the polygon and so in its bounding box, whose sides
+    // keep the intersection bounded
+    auto box = bounding_corners(polygon);
+    Kernel::Point_2 lower_right(box.second.x(), box.first.y()),
+        upper_left(box.first.x(), box.second.y());
+    std::vector<Kernel::Line_2> lines = {
+        Kernel::Line_2(box.first, lower_right),
+        Kernel::Line_2(lower_right, box.second),
+        Kernel::Line_2(box.second, upper_left),
+        Kernel::Line_2(upper_left, box.first)};
+    for (std::size_t i = 0; i < polygon.size(); ++i)
+        lines.emplace_back(polygon[i], polygon[(i + 1) % polygon.size()]);
+    std::sort(lines.begin(), lines.end(),
+              [](const Kernel::Line_2 &l, const Kernel::Line_2 &m) {
+                  return l.direction() < m.direction();
+              });
+    std::vector<Kernel::Line_2> sorted;
+    for (const auto &line : lines) {
+        if (sorted.empty() || sorted.back().direction() != line.direction())
+            sorted.push_back(line);
+        else if (sorted.back().has_on_positive_side(line.point()))
+            sorted.back() = line;
+    }
+    return sorted;
+}
+
+/// Intersection point of two lines that aren't parallel.
+Kernel::Point_2 crossing(const Kernel::Line_2 &l, const Kernel::Line_2 &m) {
+    auto result = CGAL::intersection(l, m);
+    return *boost::get<Kernel::Point_2>(&*result);
+}
+
+/// Checks whether the direction of m turns left from the direction of l by
+/// less than a half turn.
+bool turns_left(const Kernel::Line_2 &l, const Kernel::Line_2 &m) {
+    return CGAL::orientation(l.to_vector(), m.to_vector()) == CGAL::LEFT_TURN;
+}
+
+/// Drops repeated vertices of a convex polygon, which may be degenerate, and
+/// turns a degenerate one into its end points in lexicographic order.
+vec_t distinct_vertices(vec_t convex) {
+    convex.erase(std::unique(convex.begin(), convex.end()), convex.end());
+    while (convex.size() > 1 && convex.front() == convex.back())
+        convex.pop_back();
+    for (std::size_t i = 2; i < convex.size(); ++i)
+        if (!CGAL::collinear(convex[0], convex[1], convex[i]))
+            return convex;
+    if (convex.size() < 2)
+        return convex;
+    auto ends = std::minmax_element(convex.begin(), convex.end());
+    return {*ends.first, *ends.second};
+}
+
+vec_t polygon_kernel(const vec_t &vertices) {
+    if (vertices.size() < 3)
+        return {};
+    vec_t polygon = vertices;
+    if (CGAL::orientation_2(polygon.begin(), polygon.end()) == CGAL::CLOCKWISE)
+        std::reverse(polygon.begin(), polygon.end());
+    if (CGAL::is_convex_2(polygon.begin(), polygon.end()))
+        return polygon;
+
+    // The half-planes are added in the order of their directions. The lines
+    // bounding the kernel so far are kept in a deque together with the
+    // crossings of the neighbouring ones, a new half-plane drops the lines
+    // whose crossings lie outside of it from both ends. Every crossing is
+    // built from two edges of the polygon, so no construction depends on
+    // another one.
+    std::deque<Kernel::Line_2> lines;
+    std::deque<Kernel::Point_2> crossings;
+    for (const auto &line : sorted_half_planes(polygon)) {
+        while (lines.size() > 1 &&
+               line.has_on_negative_side(crossings.back())) {
+            lines.pop_back();
+            crossings.pop_back();
+        }
+        while (lines.size() > 1 &&
+               line.has_on_negative_side(crossings.front())) {
+            lines.pop_front();
+            crossings.pop_front();
+        }
+        // the lines left turn by a half turn or more only if the half-planes
+        // between them cut off everything
+        if (!lines.empty() && !turns_left(lines.back(), line))
+            return {};
+        if (!lines.empty())
+            crossings.push_back(crossing(lines.back(), line));
+        lines.push_back(line);
+    }
+    // the first lines may cut off crossings of the last ones and vice versa
+    while (lines.size() > 2 &&
+           lines.front().has_on_negative_side(crossings.back())) {
+        lines.pop_back();
+        crossings.pop_back();
+    }
+    while (lines.size() > 2 &&
+           lines.back().has_on_negative_side(crossings.front())) {
+        lines.pop_front();
+        crossings.pop_front();
+    }
+    if (lines.size() < 3 || !turns_left(lines.back(), lines.front()))
+        return {};
+    crossings.push_back(crossing(lines.back(), lines.front()));
+    return distinct_vertices(vec_t(crossings.begin(), crossings.end()));
+}
+
+bool star_shaped_guard(const vec_t &vertices, bool vertex_guard,
+                       Kernel::Point_2 &guard) {
+    auto kernel = polygon_kernel(vertices);
+    if (kernel.empty())
+        return false;
+    for (const auto &v : vertices) {
+        if (in_convex(kernel, v)) {
+            guard = v;
+            return true;
+        }
+    }
+    if (vertex_guard)
+        return false;
+    Kernel::FT x = 0, y = 0;
+    for (const auto &p : kernel) {
+        x += p.x();
+        y += p.y();
+    }
+    guard = Kernel::Point_2(x / int(kernel.size()), y / int(kernel.size()));
+    return true;
+}
+
+bool star_shaped_solution(const vec_t &vertices, bool vertex_guard,
+                          vec_t &guards,
+                          std::vector<Arrangement_2> *guard_regions) {
+    AGP_PROFILE_SCOPE("star_shaped");
+    Kernel::Point_2 guard;
+    if (!star_shaped_guard(vertices, vertex_guard, guard))
+        return false;
+    guards = {guard};
+    if (guard_regions) {
+        guard_regions->emplace_back();
+        insert_polygon(guard_regions->back(), vertices.begin(),
+                       vertices.end());
+    }
+    return true;
+}
@@ -22,15 +22,28 @@ arrangements_to_polygons(const std::vector<Arrangement_2> &arrangements) {
     return polygons;
 }
 
-std::vector<Kernel::Point_2>
-face_vertices(const Arrangement_2::Face_const_handle &face) {
-    std::vector<Kernel::Point_2> vertices;
-    Arrangement_2::Ccb_halfedge_const_circulator circ = face->outer_ccb(),
-                                                 curr = circ;
-    auto v = curr->source()->point();
-    do {
-        vertices.push_back(v);
-        v = curr->target()->point();
-    } while (++curr != circ);
+std::size_t total_vertices(const std::vector<Arrangement_2> &arrangements) {
+    std::size_t vertices = 0;
+    for (const auto &arr : arrangements) {
+        vertices += arr.number_of_vertices();
+    }
+    return vertices;
+}
+
+std::size_t total_vertices(const std::vector<region_handle> &regions) {
+    std::size_t vertices = 0;
+    for (const auto &region : regions) {
+        vertices += region->number_of_vertices();
+    }
     return vertices;
 }
+
+std::vector<region_handle> share_regions(std::vector<Arrangement_2> &&regions) {
+    auto store =
+        std::make_shared<const std::vector<Arrangement_2>>(std::move(regions));
+    std::vector<region_handle> handles;
+    handles.reserve(store->size());
+    for (const auto &region : *store)
+        handles.emplace_back(store, &region);
+    return handles;
+}
@@ -0,0 +1,155 @@
+#include <agp/arrangement/compaction.h>
+#include <agp/arrangement/partition.h>
+#include <agp/arrangement/verification.h>
+#include <agp/parallel/thread_pool.h>
+#include <agp/profile/profiler.h>
+
+#include <CGAL/Arr_landmarks_point_location.h>
+#include <CGAL/Polygon_set_2.h>
+#include <CGAL/Triangular_expansion_visibility_2.h>
+
+#include <algorithm>
+
+using Polygon_set_2 = CGAL::Polygon_set_2<Kernel>;
+using Polygon_with_holes_2 = CGAL::Polygon_with_holes_2<Kernel>;
+using TEV = CGAL::Triangular_expansion_visibility_2<Arrangement_2>;
+using Landmarks_pl = CGAL::Arr_landmarks_point_location<Arrangement_2>;
+
+/// Boundary of the bounded face of a visibility region, counterclockwise.
+static Polygon_2 region_boundary(const Arrangement_2 &region) {
+    Polygon_2 boundary;
+    for (auto f = region.faces_begin(); f != region.faces_end(); ++f) {
+        if (f->is_unbounded())
+            continue;
+        auto circ = f->outer_ccb(), curr = circ;
+        do {
+            boundary.push_back(curr->source()->point());
+        } while (++curr != circ);
+        break;
+    }
+    return boundary;
+}
+
+/// Visibility region of a point lying inside the polygon or on its boundary,
+/// computed with a shared visibility structure.
+static Polygon_2 guard_region(const TEV &tev, const Landmarks_pl &pl,
+                              const Kernel::Point_2 &guard) {
+    Arrangement_2 output;
+    auto location = pl.locate(guard);
+    if (auto v = boost::get<Arrangement_2::Vertex_const_handle>(&location)) {
+        auto circ = (*v)->incident_halfedges(), curr = circ;
+        while (curr->face()->is_unbounded())
+            ++curr;
+        tev.compute_visibility(guard, curr, output);
+    } else if (auto e = boost::get<Arrangement_2::Halfedge_const_handle>(
+                   &location)) {
+        auto he = (*e)->face()->is_unbounded() ? (*e)->twin() : *e;
+        tev.compute_visibility(guard, he, output);
+    } else {
+        auto f = boost::get<Arrangement_2::Face_const_handle>(location);
+        tev.compute_visibility(guard, f, output);
+    }
+    return region_boundary(output);
+}
+
+/// Union of visibility regions of the guards. Runs on a worker thread, so
+/// it gets its own copies of the points.
+static Polygon_set_2 regions_union(std::vector<Kernel::Point_2> vertices,
+                                   std::vector<Kernel::Point_2> guards) {
+    auto polygon = create_arrangement<Arrangement_2>(vertices);
+    TEV tev(polygon);
+    Landmarks_pl pl(polygon);
+    std::vector<Polygon_2> regions;
+    regions.reserve(guards.size());
+    for (const auto &g : guards)
+        regions.push_back(guard_region(tev, pl, g));
+
+    Polygon_set_2 result;
+    result.join(regions.begin(), regions.end());
+    return result;
+}
+
+/// Points inside a region of a polygon set, at least one for the region.
+static void region_witnesses(const Polygon_with_holes_2 &region,
+                             std::vector<Kernel::Point_2> &witnesses) {
+    arena_scope scope;
+    Arena_arrangement_2 arr;
+    std::vector<Traits::X_monotone_curve_2> edges;
+    auto add_edges = [&](const Polygon_2 &boundary) {
+        for (auto e = boundary.edges_begin(); e != boundary.edges_end(); ++e)
+            edges.emplace_back(e->source(), e->target());
+    };
+    add_edges(region.outer_boundary());
+    for (auto h = region.holes_begin(); h != region.holes_end(); ++h)
+        add_edges(*h);
+    CGAL::insert(arr, edges.begin(), edges.end());
+
+    // Faces of the arrangement are the region itself and its holes, only
+    // points outside of the holes are kept.
+    for (const auto &p : arr_discretization(arr)) {
+        if (region.outer_boundary().bounded_side(p) != CGAL::ON_BOUNDED_SIDE)
+            continue;
+        bool in_hole = std::any_of(
+            region.holes_begin(), region.holes_end(),
+            [&](const Polygon_2 &h) {
+                return h.bounded_side(p) != CGAL::ON_UNBOUNDED_SIDE;
+            });
+        if (!in_hole)
+            witnesses.push_back(p);
+    }
+}
+
+std::vector<Kernel::Point_2>
+verify_guards(const std::vector<Kernel::Point_2> &vertices,
+              const std::vector<Kernel::Point_2> &guards, unsigned threads) {
+    AGP_PROFILE_SCOPE("verify_guards");
+    if (threads == 0)
+        threads = thread_count();
+    threads = std::max<std::size_t>(1, std::min<std::size_t>(threads,
+                                                             guards.size()));
+
+    auto &pool = default_thread_pool();
+    std::vector<std::future<Polygon_set_2>> unions;
+    std::size_t chunk = (guards.size() + threads - 1) / threads;
+    for (std::size_t begin = 0; begin < guards.size(); begin += chunk) {
+        std::vector<Kernel::Point_2> part(
+            guards.begin() + begin,
+            guards.begin() + std::min(begin + chunk, guards.size()));
+        unions.push_back(pool.submit(
+            [vertices = detached_copy(vertices),
+             part = detached_copy(part)]() mutable {
+                return regions_union(std::move(vertices), std::move(part));
+            }));
+    }
+
+    // Tree reduction, each round joins pairs of unions in parallel. Every
+    // union is used by a single task, so no lazy object is shared between
+    // threads.
+    std::vector<Polygon_set_2> level;
+    pool.wait_all(unions);
+    for (auto &u : unions)
+        level.push_back(u.get());
+    for (std::size_t step = 1; step < level.size(); step *= 2) {
+        std::vector<std::future<void>> joins;
+        for (std::size_t i = 0; i + step < level.size(); i += 2 * step) {
+            joins.push_back(pool.submit(
+                [&level, i, step] { level[i].join(level[i + step]); }));
+        }
+        // the joins refer to level, so none may still run when one throws
+        pool.wait_all(joins);
+        for (auto &j : joins)
+            j.get();
+    }
+
+    Polygon_set_2 uncovered(create_polygon(vertices));
+    if (!level.empty())
+        uncovered.difference(level.front());
+
+    std::vector<Polygon_with_holes_2> regions;
+    uncovered.polygons_with_holes(std::back_inserter(regions));
+    std::vector<Kernel::Point_2> witnesses;
+    for (const auto &r : regions)
+        region_witnesses(r, witnesses);
+    AGP_PROFILE_COUNT("uncovered_regions", regions.size());
+    return witnesses;
+}
@@ -1,6 +1,10 @@
 #include "agp/arrangement/visibility.h"
+#include "agp/arrangement/compaction.h"
+#include "agp/parallel/thread_pool.h"
 // #define NDEBUG
+#include <algorithm>
 #include <cassert>
+#include <memory>
 
 bool point_visible(const Arrangement_2 &arr, const Kernel::Point_2 &point) {
     CGAL::Arr_walk_along_line_point_location<Arrangement_2> pl(arr);
@@ -12,78 +16,175 @@ bool point_visible(const Arrangement_2 &arr, const Kernel::Point_2 &point) {
     return true;
 }
 
-Arrangement_2 vertex_visibility_region(const Arrangement_2 &polygon,
-                                       const Kernel::Point_2 &point) {
+/// Computes visibility region of a vertex of the polygon into output.
+void vertex_visibility_region(const Arrangement_2 &polygon,
+                              const Kernel::Point_2 &point,
+                              Arrangement_2 &output) {
     auto he = polygon.halfedges_begin();
     while (he->target()->point() != point || he->face()->is_unbounded())
         he++;
-    Arrangement_2 output;
     typedef CGAL::Triangular_expansion_visibility_2<Arrangement_2> TEV;
     TEV tev(polygon);
     tev.compute_visibility(point, he, output);
-    return output;
 }
 
-Arrangement_2
-edge_point_visibility_region(const Arrangement_2 &polygon,
-                             const Kernel::Point_2 &point,
-                             const Arrangement_2::Halfedge_const_handle &he) {
+Arrangement_2 vertex_visibility_region(const Arrangement_2 &polygon,
+                                       const Kernel::Point_2 &point) {
     Arrangement_2 output;
+    vertex_visibility_region(polygon, point, output);
+    return output;
+}
+
+void edge_point_visibility_region(
+    const Arrangement_2 &polygon, const Kernel::Point_2 &point,
+    const Arrangement_2::Halfedge_const_handle &he, Arrangement_2 &output) {
     typedef CGAL::Triangular_expansion_visibility_2<Arrangement_2> TEV;
     TEV tev(polygon);
     tev.compute_visibility(point, he, output);
-    return output;
 }
 
-Arrangement_2 general_point_visibility_region(const Arrangement_2 &polygon,
-                                              const Kernel::Point_2 &point) {
+/// Computes visibility region of a point in the interior into output.
+void inner_point_visibility_region(const Arrangement_2 &polygon,
+                                   const Kernel::Point_2 &point,
+                                   Arrangement_2 &output) {
+    assert(polygon.number_of_faces() == 2);
+
+    Arrangement_2::Face_const_handle f = polygon.faces_begin();
+    for (; f != polygon.faces_end(); ++f) {
+        if (!f->is_unbounded())
+            break;
+    }
+
+    typedef CGAL::Triangular_expansion_visibility_2<Arrangement_2> TEV;
+    TEV tev(polygon);
+    tev.compute_visibility(point, f, output);
+}
+
+void general_point_visibility_region(const Arrangement_2 &polygon,
+                                     const Kernel::Point_2 &point,
+                                     Arrangement_2 &output) {
     CGAL::Arr_walk_along_line_point_location<Arrangement_2> pl(polygon);
     auto result = pl.locate(point);
     if (boost::get<Arrangement_2::Vertex_const_handle>(&result))
-        return vertex_visibility_region(polygon, point);
+        vertex_visibility_region(polygon, point, output);
     else if (auto e =
                  boost::get<Arrangement_2::Halfedge_const_handle>(&result)) {
         if ((*e)->face()->is_unbounded())
-            return edge_point_visibility_region(polygon, point, (*e)->twin());
+            edge_point_visibility_region(polygon, point, (*e)->twin(), output);
         else
-            return edge_point_visibility_region(polygon, point, *e);
+            edge_point_visibility_region(polygon, point, *e, output);
+    } else
+        inner_point_visibility_region(polygon, point, output);
+}
+
+Arrangement_2 general_point_visibility_region(const Arrangement_2 &polygon,
+                                              const Kernel::Point_2 &point) {
+    Arrangement_2 output;
+    general_point_visibility_region(polygon, point, output);
+    return output;
+}
+
+region_handle visibility_region_handle(const Arrangement_2 &polygon,
+                                       const Kernel::Point_2 &point) {
+    auto region = std::make_shared<Arrangement_2>();
+    general_point_visibility_region(polygon, point, *region);
+    return region;
+}
+
+std::vector<region_handle>
+visibility_region_handles(const Arrangement_2 &polygon,
+                          const std::vector<Kernel::Point_2> &points) {
+    // one point location and one triangulation of the polygon are shared by
+    // all the points
+    CGAL::Arr_walk_along_line_point_location<Arrangement_2> pl(polygon);
+    typedef CGAL::Triangular_expansion_visibility_2<Arrangement_2> TEV;
+    TEV tev(polygon);
+    std::vector<region_handle> regions;
+    regions.reserve(points.size());
+    for (const auto &point : points) {
+        auto region = std::make_shared<Arrangement_2>();
+        auto result = pl.locate(point);
+        if (boost::get<Arrangement_2::Vertex_const_handle>(&result)) {
+            auto he = polygon.halfedges_begin();
+            while (he->target()->point() != point ||
+                   he->face()->is_unbounded())
+                he++;
+            tev.compute_visibility(point, he, *region);
+        } else if (auto e = boost::get<Arrangement_2::Halfedge_const_handle>(
+                       &result)) {
+            tev.compute_visibility(
+                point, (*e)->face()->is_unbounded() ? (*e)->twin() : *e,
+                *region);
+        } else {
+            auto f = boost::get<Arrangement_2::Face_const_handle>(&result);
+            tev.compute_visibility(point, *f, *region);
+        }
+        regions.push_back(std::move(region));
     }
-    return inner_point_visibility_region(polygon, point);
+    return regions;
 }
 
 Arrangement_2 inner_point_visibility_region(const Arrangement_2 &polygon,
                                             const Kernel::Point_2 &point) {
-    assert(polygon.number_of_faces() == 2);
+    Arrangement_2 output;
+    inner_point_visibility_region(polygon, point, output);
+    return output;
+}
 
-    Arrangement_2::Face_const_handle f = polygon.faces_begin();
-    for (; f != polygon.faces_end(); ++f) {
-        if (!f->is_unbounded())
-            break;
-    }
+/// Computes visibility regions of points[begin..end), which are consecutive
+/// vertices of the polygon, into the corresponding elements of regions.
+void vertex_visibility_regions(const Arrangement_2 &polygon,
+                               const std::vector<Kernel::Point_2> &points,
+                               std::size_t begin, std::size_t end,
+                               std::vector<Arrangement_2> &regions) {
+    const auto &previous = points[(begin + points.size() - 1) % points.size()];
+    Arrangement_2::Halfedge_const_handle he = polygon.halfedges_begin();
+    while (he->target()->point() != points[begin] ||
+           he->source()->point() != previous)
+        he++;
 
-    Arrangement_2 output;
     typedef CGAL::Triangular_expansion_visibility_2<Arrangement_2> TEV;
     TEV tev(polygon);
-    tev.compute_visibility(point, f, output);
-    return output;
+    for (std::size_t i = begin; i < end; ++i) {
+        tev.compute_visibility(points[i], he, regions[i]);
+        he = he->next();
+    }
 }
 
 std::vector<Arrangement_2>
 all_visibility_regions(const Arrangement_2 &polygon,
                        const std::vector<Kernel::Point_2> &points) {
+    // regions are computed in place, arrangements have no move constructor
+    // and reallocating or assigning them copies their DCELs
     std::vector<Arrangement_2> visibility_regions(points.size());
-    Arrangement_2::Halfedge_const_handle he = polygon.halfedges_begin();
-    while (he->target()->point() != points[0] ||
-           he->source()->point() != points[points.size() - 1])
-        he++;
+    if (points.empty())
+        return visibility_regions;
+    std::size_t tasks = std::min<std::size_t>(thread_count(),
+                                              points.size() / 256);
+    if (tasks <= 1) {
+        vertex_visibility_regions(polygon, points, 0, points.size(),
+                                  visibility_regions);
+        return visibility_regions;
+    }
 
-    typedef CGAL::Triangular_expansion_visibility_2<Arrangement_2> TEV;
-    TEV tev(polygon);
-    for (unsigned i = 0; i < points.size(); ++i) {
-        Arrangement_2 output;
-        tev.compute_visibility(points[i], he, output);
-        visibility_regions[i] = output;
-        he = he->next();
+    // Every task builds its own polygon from detached copies of the points
+    // and fills its own range of the regions.
+    auto &pool = default_thread_pool();
+    std::vector<std::future<void>> parts;
+    for (std::size_t t = 0; t < tasks; ++t) {
+        std::size_t begin = points.size() * t / tasks;
+        std::size_t end = points.size() * (t + 1) / tasks;
+        parts.push_back(pool.submit([vertices = detached_copy(points), begin,
+                                     end, &visibility_regions] {
+            auto own = create_arrangement<Arrangement_2>(vertices);
+            vertex_visibility_regions(own, vertices, begin, end,
+                                      visibility_regions);
+        }));
     }
+    // all the tasks write into the result, so they have to finish before an
+    // exception is rethrown
+    pool.wait_all(parts);
+    for (auto &part : parts)
+        part.get();
     return visibility_regions;
 }
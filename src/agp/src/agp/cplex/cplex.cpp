@@ -1,4 +1,23 @@
 #include "../../../include/agp/cplex/cplex.h"
+#include "../../../include/agp/parallel/thread_pool.h"
+
+/// Number of workers CPLEX may take besides the calling thread. The library
+/// runs thread_count() threads, the pool workers and the main thread. A
+/// caller that is itself a worker leaves the main thread free, which keeps
+/// running pool tasks.
+unsigned wanted_workers() {
+    unsigned others = thread_count() - 1;
+    if (default_thread_pool().is_worker() && others > 0)
+        --others;
+    return others;
+}
+
+cplex_threads::cplex_threads(IloCplex &cplex)
+    : reserved_(default_thread_pool().reserve(wanted_workers())) {
+    cplex.setParam(IloCplex::Param::Threads, IloInt(1 + reserved_));
+}
+
+cplex_threads::~cplex_threads() { default_thread_pool().release(reserved_); }
 
 std::vector<int> IP_ind_solution(IloCplex &cplex, IloNumVarArray &x) {
     std::vector<int> s;
@@ -20,14 +39,30 @@ std::vector<IloNum> LP_solution(IloCplex &cplex, IloNumVarArray &x) {
 
 std::vector<int> solve_IP_model(IloCplex &cplex, IloModel &model,
                                 IloNumVarArray &x) {
+    return solve_IP_model(cplex, model, x, {});
+}
+
+std::vector<int> solve_IP_model(IloCplex &cplex, IloModel &model,
+                                IloNumVarArray &x,
+                                const std::vector<IloNum> &start) {
     cplex.extract(model);
-    cplex.solve();
+    if (!start.empty()) {
+        IloNumArray values(x.getEnv(), x.getSize());
+        for (IloInt i = 0; i < x.getSize(); ++i)
+            values[i] = start[i];
+        cplex.addMIPStart(x, values, IloCplex::MIPStartRepair);
+        values.end();
+    }
+    cplex_threads threads(cplex);
+    if (!cplex.solve())
+        return {};
     return IP_ind_solution(cplex, x);
 }
 
 std::vector<IloNum> solve_LP_model(IloCplex &cplex, IloModel &model,
                                    IloNumVarArray &x) {
     cplex.extract(model);
+    cplex_threads threads(cplex);
     cplex.solve();
     return LP_solution(cplex, x);
 }
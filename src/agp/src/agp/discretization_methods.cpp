@@ -1,4 +1,13 @@
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/partition.h>
 #include <agp/discretization_methods.h>
+#include <agp/io/visibility_cache.h>
+#include <agp/parallel/arena.h>
+#include <agp/profile/profiler.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
 
 std::vector<Kernel::Point_2>
 single_vertex(const std::vector<Kernel::Point_2> &points) {
@@ -42,7 +51,10 @@ discretization_min_dist(const std::vector<Kernel::Point_2> &points) {
 
     while (last.y() <= y.back()) {
         while (last.x() <= x.back()) {
-            discretization_set.insert(Kernel::Point_2(last));
+            // witnesses outside the polygon can't be seen by any guard
+            if (CGAL::bounded_side_2(points.begin(), points.end(), last) !=
+                CGAL::ON_UNBOUNDED_SIDE)
+                discretization_set.insert(Kernel::Point_2(last));
             last = Kernel::Point_2(last.x() + min_dist_x, last.y());
         }
         last = Kernel::Point_2(x[0], last.y() + min_dist_y);
@@ -54,3 +66,100 @@ discretization_min_dist(const std::vector<Kernel::Point_2> &points) {
 
     return discretization;
 }
+
+std::vector<Kernel::Point_2>
+orthogonal_grid(const std::vector<Kernel::Point_2> &points) {
+    if (!is_orthogonal(points))
+        return all_vertices(points);
+    std::vector<Kernel::Point_2> discretization;
+    for (const auto &cell : orthogonal_cells(points))
+        discretization.push_back(
+            CGAL::midpoint(cell.lower_left, cell.upper_right));
+    return discretization;
+}
+
+/// Checks whether the vertices seeing a face are a proper subset of the
+/// vertices seeing another face.
+bool seen_by_fewer(const std::vector<bool> &face,
+                   const std::vector<bool> &other) {
+    for (std::size_t i = 0; i < face.size(); ++i)
+        if (face[i] && !other[i])
+            return false;
+    return face != other;
+}
+
+std::vector<Kernel::Point_2>
+shadow_avp(const std::vector<Kernel::Point_2> &points) {
+    AGP_PROFILE_SCOPE("shadow_avp");
+    Arrangement_2 polygon = create_arrangement<Arrangement_2>(points);
+    std::vector<Arrangement_2> visibility_regions =
+        cached_visibility_regions(polygon, points);
+    // initialized by the lambda, assigning the overlay would copy it
+    Arrangement_2 avps = [&] {
+        AGP_PROFILE_SCOPE("overlay");
+        return overlay_arrangements<Arrangement_2>(polygon, visibility_regions);
+    }();
+    AGP_PROFILE_COUNT("avps", avps.number_of_faces() - 1);
+
+    // one interior point of each AVP locates it in the visibility regions
+    std::map<const void *, std::size_t> face_index;
+    std::vector<Kernel::Point_2> interior;
+    std::vector<std::vector<bool>> seen;
+    for (auto f = avps.faces_begin(); f != avps.faces_end(); ++f) {
+        if (f->is_unbounded())
+            continue;
+        face_index[&*f] = interior.size();
+        interior.push_back(discretize_reflex(face_vertices(f)).front());
+        std::vector<bool> seen_from(visibility_regions.size());
+        for (std::size_t i = 0; i < visibility_regions.size(); ++i)
+            seen_from[i] =
+                point_visible(visibility_regions[i], interior.back());
+        seen.push_back(std::move(seen_from));
+    }
+
+    std::set<std::vector<bool>> shadows;
+    std::vector<Kernel::Point_2> discretization;
+    for (auto f = avps.faces_begin(); f != avps.faces_end(); ++f) {
+        if (f->is_unbounded())
+            continue;
+        std::size_t index = face_index[&*f];
+        bool shadow = true;
+        auto circ = f->outer_ccb(), curr = circ;
+        do {
+            auto neighbour = curr->twin()->face();
+            shadow = neighbour->is_unbounded() ||
+                     !seen_by_fewer(seen[face_index[&*neighbour]],
+                                    seen[index]);
+        } while (shadow && ++curr != circ);
+        if (shadow && shadows.insert(seen[index]).second)
+            discretization.push_back(interior[index]);
+    }
+    return discretization;
+}
+
+std::vector<Kernel::Point_2>
+reflex_extension(const std::vector<Kernel::Point_2> &points) {
+    AGP_PROFILE_SCOPE("reflex_extension");
+    std::vector<Kernel::Point_2> vertices = points;
+    if (CGAL::orientation_2(vertices.begin(), vertices.end()) ==
+        CGAL::CLOCKWISE)
+        std::reverse(vertices.begin(), vertices.end());
+
+    arena_scope scope;
+    Arena_arrangement_2 arr;
+    std::vector<Traits::X_monotone_curve_2> edges;
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+        edges.emplace_back(vertices[i], vertices[(i + 1) % vertices.size()]);
+    for (const auto &chord : extension_chords(vertices))
+        edges.emplace_back(chord.source(), chord.target());
+    CGAL::insert(arr, edges.begin(), edges.end());
+    AGP_PROFILE_COUNT("extension_faces", arr.number_of_faces() - 1);
+
+    // the chords split every reflex angle, so all the faces are convex
+    std::vector<Kernel::Point_2> discretization;
+    for (auto f = arr.faces_begin(); f != arr.faces_end(); ++f) {
+        if (!f->is_unbounded())
+            discretization.push_back(small_interior_point(face_vertices(f)));
+    }
+    return discretization;
+}
@@ -0,0 +1,261 @@
+#include <agp/generators/polygon_generators.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_set>
+
+using int128 = __int128;
+
+struct grid_point {
+    std::int64_t x, y;
+};
+
+Kernel::Point_2 to_point(std::int64_t x, std::int64_t y) {
+    // Coordinates are below 2^53, so they are represented exactly.
+    return Kernel::Point_2(static_cast<double>(x), static_cast<double>(y));
+}
+
+/// Random number from [0, bound), the small modulo bias is irrelevant here.
+std::uint64_t random_below(std::mt19937_64 &gen, std::uint64_t bound) {
+    return gen() % bound;
+}
+
+/// Sign of the cross product (b - a) x (c - a).
+int orientation(const grid_point &a, const grid_point &b,
+                const grid_point &c) {
+    int128 cross = int128(b.x - a.x) * (c.y - a.y) -
+                   int128(b.y - a.y) * (c.x - a.x);
+    return (cross > 0) - (cross < 0);
+}
+
+/// A chain from p to q through the points idx[begin, end).
+struct chain_task {
+    std::size_t begin, end, p, q;
+};
+
+/// Appends a chain from p to q (without q) through the given points, all
+/// lying on one side of the line pq.
+void space_partition_chain(const std::vector<grid_point> &points,
+                           std::vector<std::size_t> &idx, chain_task first,
+                           std::mt19937_64 &gen,
+                           std::vector<std::size_t> &chain) {
+    const std::int64_t denominator = std::int64_t(1) << 20;
+    std::vector<chain_task> stack = {first};
+    while (!stack.empty()) {
+        auto task = stack.back();
+        stack.pop_back();
+        const auto &p = points[task.p], &q = points[task.q];
+        if (task.begin == task.end) {
+            chain.push_back(task.p);
+            continue;
+        }
+
+        // r must not lie on the line pq, otherwise no line through r
+        // separates p from q.
+        std::size_t j =
+            task.begin + random_below(gen, task.end - task.begin);
+        if (orientation(p, q, points[idx[j]]) == 0) {
+            j = task.begin;
+            while (j < task.end && orientation(p, q, points[idx[j]]) == 0)
+                ++j;
+        }
+        if (j == task.end) {
+            std::sort(idx.begin() + task.begin, idx.begin() + task.end,
+                      [&](std::size_t a, std::size_t b) {
+                          return int128(points[a].x - p.x) * (q.x - p.x) +
+                                     int128(points[a].y - p.y) * (q.y - p.y) <
+                                 int128(points[b].x - p.x) * (q.x - p.x) +
+                                     int128(points[b].y - p.y) * (q.y - p.y);
+                      });
+            chain.push_back(task.p);
+            chain.insert(chain.end(), idx.begin() + task.begin,
+                         idx.begin() + task.end);
+            continue;
+        }
+        std::swap(idx[task.begin], idx[j]);
+        std::size_t r = idx[task.begin];
+        const auto &rp = points[r];
+
+        // s = p + k / denominator * (q - p) is a random point of the open
+        // segment pq, the line rs separates p from q.
+        std::int64_t k = 1 + random_below(gen, denominator - 1);
+        int128 dx = int128(p.x) * denominator + int128(k) * (q.x - p.x) -
+                    int128(rp.x) * denominator;
+        int128 dy = int128(p.y) * denominator + int128(k) * (q.y - p.y) -
+                    int128(rp.y) * denominator;
+        auto side = [&](const grid_point &c) {
+            int128 cross = dx * (c.y - rp.y) - dy * (c.x - rp.x);
+            return (cross > 0) - (cross < 0);
+        };
+        int p_side = side(p);
+        auto middle = std::stable_partition(
+            idx.begin() + task.begin + 1, idx.begin() + task.end,
+            [&](std::size_t i) { return side(points[i]) != -p_side; });
+        std::size_t mid = middle - idx.begin();
+        stack.push_back({mid, task.end, r, task.q});
+        stack.push_back({task.begin + 1, mid, task.p, r});
+    }
+}
+
+std::vector<Kernel::Point_2> random_polygon(std::size_t n,
+                                            std::uint64_t seed) {
+    if (n < 3)
+        throw std::invalid_argument("a polygon needs at least 3 vertices");
+
+    const std::uint64_t range = std::uint64_t(1) << 30;
+    std::mt19937_64 gen(seed);
+    std::vector<grid_point> points;
+    std::unordered_set<std::uint64_t> used;
+    points.reserve(n);
+    while (points.size() < n) {
+        std::uint64_t x = random_below(gen, range);
+        std::uint64_t y = random_below(gen, range);
+        if (used.insert(x << 32 | y).second)
+            points.push_back({std::int64_t(x), std::int64_t(y)});
+    }
+
+    auto by_x = [&](std::size_t a, std::size_t b) {
+        return std::tie(points[a].x, points[a].y) <
+               std::tie(points[b].x, points[b].y);
+    };
+    std::vector<std::size_t> idx(n);
+    for (std::size_t i = 0; i < n; ++i)
+        idx[i] = i;
+    std::size_t p = *std::min_element(idx.begin(), idx.end(), by_x);
+    std::size_t q = *std::max_element(idx.begin(), idx.end(), by_x);
+    idx.erase(std::remove_if(idx.begin(), idx.end(),
+                             [&](std::size_t i) { return i == p || i == q; }),
+              idx.end());
+
+    // Points below the line pq form the lower chain from p to q and the
+    // points above it the upper chain back from q to p. Partitions keep the
+    // order of the points, which std::partition leaves to the library.
+    auto middle =
+        std::stable_partition(idx.begin(), idx.end(), [&](std::size_t i) {
+            return orientation(points[p], points[q], points[i]) <= 0;
+        });
+    std::size_t mid = middle - idx.begin();
+    std::vector<std::size_t> chain;
+    chain.reserve(n);
+    space_partition_chain(points, idx, {0, mid, p, q}, gen, chain);
+    space_partition_chain(points, idx, {mid, idx.size(), q, p}, gen, chain);
+
+    std::vector<Kernel::Point_2> polygon;
+    polygon.reserve(n);
+    for (auto i : chain)
+        polygon.push_back(to_point(points[i].x, points[i].y));
+    return polygon;
+}
+
+std::vector<Kernel::Point_2> orthogonal_polygon(std::size_t n,
+                                                std::uint64_t seed) {
+    if (n < 4)
+        throw std::invalid_argument(
+            "an orthogonal polygon needs at least 4 vertices");
+
+    const std::int64_t height = 1000;
+    std::mt19937_64 gen(seed);
+    std::size_t columns = n / 4;
+    std::vector<std::int64_t> bottom(columns), top(columns);
+    for (std::size_t i = 0; i < columns; ++i) {
+        // Bottoms lie below height / 2 and tops above it, so neighbouring
+        // columns always overlap.
+        do {
+            bottom[i] = random_below(gen, height / 2);
+        } while (i > 0 && bottom[i] == bottom[i - 1]);
+        do {
+            top[i] = height / 2 + 1 + random_below(gen, height / 2);
+        } while (i > 0 && top[i] == top[i - 1]);
+    }
+
+    std::vector<Kernel::Point_2> polygon;
+    polygon.reserve(4 * columns);
+    for (std::size_t i = 0; i < columns; ++i) {
+        polygon.push_back(to_point(i, bottom[i]));
+        polygon.push_back(to_point(i + 1, bottom[i]));
+    }
+    for (std::size_t i = columns; i-- > 0;) {
+        polygon.push_back(to_point(i + 1, top[i]));
+        polygon.push_back(to_point(i, top[i]));
+    }
+    return polygon;
+}
+
+void von_koch_edge(const grid_point &a, const grid_point &b, unsigned level,
+                   std::vector<Kernel::Point_2> &polygon) {
+    if (level == 0) {
+        polygon.push_back(to_point(a.x, a.y));
+        return;
+    }
+    // The outer normal of a counterclockwise edge points to its right.
+    std::int64_t dx = (b.x - a.x) / 5, dy = (b.y - a.y) / 5;
+    grid_point corners[6] = {a,
+                             {a.x + 2 * dx, a.y + 2 * dy},
+                             {a.x + 2 * dx + dy, a.y + 2 * dy - dx},
+                             {a.x + 3 * dx + dy, a.y + 3 * dy - dx},
+                             {a.x + 3 * dx, a.y + 3 * dy},
+                             b};
+    for (int i = 0; i < 5; ++i)
+        von_koch_edge(corners[i], corners[i + 1], level - 1, polygon);
+}
+
+std::vector<Kernel::Point_2> von_koch_polygon(unsigned level) {
+    if (level > 12)
+        throw std::invalid_argument("von Koch level must be at most 12");
+
+    std::int64_t side = 1;
+    for (unsigned i = 0; i < level; ++i)
+        side *= 5;
+    grid_point square[5] = {{0, 0}, {side, 0}, {side, side}, {0, side}, {0, 0}};
+    std::vector<Kernel::Point_2> polygon;
+    polygon.reserve(4 * side);
+    for (int i = 0; i < 4; ++i)
+        von_koch_edge(square[i], square[i + 1], level, polygon);
+    return polygon;
+}
+
+std::vector<Kernel::Point_2> spiral_polygon(std::size_t n) {
+    if (n < 6)
+        throw std::invalid_argument("a spiral needs at least 6 vertices");
+
+    // The corridor is 400 units wide and moves away from the origin by 1000
+    // units per turn, so its neighbouring turns never meet.
+    const unsigned per_turn = 16;
+    const double width = 400, growth = 1000;
+    std::size_t m = n / 2;
+    std::vector<Kernel::Point_2> outer, inner;
+    outer.reserve(2 * m);
+    inner.reserve(m);
+    for (std::size_t i = 0; i < m; ++i) {
+        double angle = 2 * M_PI * i / per_turn;
+        double r = growth * (1 + angle / (2 * M_PI));
+        outer.push_back(to_point(std::llround((r + width) * std::cos(angle)),
+                                 std::llround((r + width) * std::sin(angle))));
+        inner.push_back(to_point(std::llround(r * std::cos(angle)),
+                                 std::llround(r * std::sin(angle))));
+    }
+    outer.insert(outer.end(), inner.rbegin(), inner.rend());
+    return outer;
+}
+
+std::vector<Kernel::Point_2> comb_polygon(std::size_t teeth) {
+    if (teeth < 1)
+        throw std::invalid_argument("a comb needs at least one tooth");
+
+    // Teeth are 2 units wide, 2 units apart and 8 units high, so the
+    // regions seeing the tips of neighbouring teeth are disjoint.
+    const std::int64_t base = 2, tip = 10;
+    std::int64_t k = teeth;
+    std::vector<Kernel::Point_2> polygon = {to_point(0, 0),
+                                            to_point(4 * k - 2, 0)};
+    polygon.reserve(3 * teeth + 2);
+    for (std::int64_t i = k - 1; i >= 0; --i) {
+        polygon.push_back(to_point(4 * i + 2, base));
+        polygon.push_back(to_point(4 * i + 1, tip));
+        polygon.push_back(to_point(4 * i, base));
+    }
+    return polygon;
+}
@@ -1,10 +1,18 @@
+#include <agp/arrangement/partition.h>
 #include <agp/initial_placements.h>
+#include <agp/io/visibility_cache.h>
 
-wg_placement every_second(const std::vector<Kernel::Point_2> &points) {
+#include <set>
+#include <stdexcept>
+
+using vec_t = std::vector<Kernel::Point_2>;
+
+wg_placement every_second(const vec_t &points) {
     wg_placement wg;
     Arrangement_2 arr_polygon = create_arrangement<Arrangement_2>(points);
-    std::vector<Arrangement_2> visibility_regions =
-        all_visibility_regions(arr_polygon, points);
+    // handles share the computed regions, which are never copied
+    std::vector<region_handle> visibility_regions =
+        share_regions(cached_visibility_regions(arr_polygon, points));
     unsigned i = 0, n = points.size() - 1;
     while (i < n) {
         wg.guards.push_back(points[i]);
@@ -21,3 +29,132 @@ wg_placement every_second(const std::vector<Kernel::Point_2> &points) {
 
     return wg;
 }
+
+/// Vertices in counterclockwise order.
+vec_t counterclockwise(const vec_t &points) {
+    if (CGAL::orientation_2(points.begin(), points.end()) != CGAL::CLOCKWISE)
+        return points;
+    return vec_t(points.rbegin(), points.rend());
+}
+
+/// Indices of the reflex vertices of a counterclockwise polygon.
+std::vector<std::size_t> reflex_indices(const vec_t &points) {
+    std::vector<std::size_t> reflex;
+    std::size_t n = points.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (CGAL::orientation(points[(i + n - 1) % n], points[i],
+                              points[(i + 1) % n]) == CGAL::RIGHT_TURN)
+            reflex.push_back(i);
+    }
+    return reflex;
+}
+
+/// Interior points of the convex components of a counterclockwise polygon.
+vec_t component_points(const vec_t &points) {
+    auto discretization = discretize_reflex(points);
+    return vec_t(discretization.begin(), discretization.end());
+}
+
+/// Placement whose guards and witnesses are vertices, given by indices.
+wg_placement vertex_placement(const vec_t &points,
+                              const std::vector<std::size_t> &guards,
+                              const std::vector<std::size_t> &witnesses) {
+    wg_placement wg;
+    Arrangement_2 arr_polygon = create_arrangement<Arrangement_2>(points);
+    auto regions =
+        share_regions(cached_visibility_regions(arr_polygon, points));
+    for (auto i : guards) {
+        wg.guards.push_back(points[i]);
+        wg.guard_visibility.push_back(regions[i]);
+    }
+    for (auto i : witnesses) {
+        wg.witnesses.push_back(points[i]);
+        wg.witness_visibility.push_back(regions[i]);
+    }
+    return wg;
+}
+
+wg_placement reflex_guards(const vec_t &vertices) {
+    auto points = counterclockwise(vertices);
+    auto reflex = reflex_indices(points);
+    std::vector<std::size_t> guards, witnesses;
+    for (std::size_t i = 0, r = 0; i < points.size(); ++i) {
+        if (r < reflex.size() && reflex[r] == i) {
+            guards.push_back(i);
+            ++r;
+        } else
+            witnesses.push_back(i);
+    }
+    // a convex polygon has no reflex vertices
+    if (guards.empty())
+        guards = witnesses;
+    return vertex_placement(points, guards, witnesses);
+}
+
+wg_placement convex_witnesses(const vec_t &vertices) {
+    auto points = counterclockwise(vertices);
+    std::vector<std::size_t> guards;
+    for (std::size_t i = 0; i < points.size(); ++i)
+        guards.push_back(i);
+    auto wg = vertex_placement(points, guards, {});
+    wg.witnesses = component_points(points);
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    wg.witness_visibility = visibility_region_handles(polygon, wg.witnesses);
+    return wg;
+}
+
+wg_placement reflex_chords(const vec_t &vertices) {
+    auto points = counterclockwise(vertices);
+    auto reflex = reflex_indices(points);
+    wg_placement wg = vertex_placement(points, reflex, {});
+
+    // the ends of the chords extending the edges at reflex vertices are
+    // candidates for guards
+    std::set<Kernel::Point_2> known(points.begin(), points.end());
+    vec_t chord_ends;
+    for (const auto &chord : extension_chords(points)) {
+        if (known.insert(chord.target()).second)
+            chord_ends.push_back(chord.target());
+    }
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto chord_regions = visibility_region_handles(polygon, chord_ends);
+    wg.guards.insert(wg.guards.end(), chord_ends.begin(), chord_ends.end());
+    wg.guard_visibility.insert(wg.guard_visibility.end(),
+                               chord_regions.begin(), chord_regions.end());
+
+    wg.witnesses = component_points(points);
+    wg.witness_visibility = visibility_region_handles(polygon, wg.witnesses);
+    return wg;
+}
+
+placement_method placement_by_name(const std::string &name) {
+    if (name == "every_second")
+        return every_second;
+    if (name == "reflex")
+        return reflex_guards;
+    if (name == "convex")
+        return convex_witnesses;
+    if (name == "chords")
+        return reflex_chords;
+    throw std::invalid_argument("unknown placement " + name);
+}
+
+placement_method with_guards(placement_method placement, vec_t guards) {
+    return [placement, guards](const vec_t &vertices) {
+        auto wg = placement(vertices);
+        std::set<Kernel::Point_2> known(wg.guards.begin(), wg.guards.end());
+        vec_t added;
+        for (const auto &g : guards) {
+            if (CGAL::bounded_side_2(vertices.begin(), vertices.end(), g) !=
+                    CGAL::ON_UNBOUNDED_SIDE &&
+                known.insert(g).second)
+                added.push_back(g);
+        }
+        auto polygon = create_arrangement<Arrangement_2>(vertices);
+        auto regions = visibility_region_handles(polygon, added);
+        wg.guards.insert(wg.guards.end(), added.begin(), added.end());
+        wg.guard_visibility.insert(wg.guard_visibility.end(), regions.begin(),
+                                   regions.end());
+        return wg;
+    };
+}
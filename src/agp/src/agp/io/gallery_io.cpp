@@ -0,0 +1,306 @@
+#include <agp/io/gallery_io.h>
+
+#include <CGAL/Fraction_traits.h>
+#include <CGAL/Gmpz.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+static_assert(sizeof(gallery_header) == 32, "unexpected header layout");
+static_assert(sizeof(gallery_metadata) % 8 == 0,
+              "unexpected metadata layout");
+
+const char gallery_magic[4] = {'A', 'G', 'P', 'B'};
+const std::uint32_t gallery_version = 1;
+const std::uint32_t metadata_flag = 1;
+
+/// Exact number type of the kernel and the integers of its fractions.
+using exact_ft = Kernel::FT::ET;
+using exact_fraction = CGAL::Fraction_traits<exact_ft>;
+using exact_int = exact_fraction::Numerator_type;
+
+/// Splits the exact value of a coordinate into a normalized fraction.
+void decompose(const Kernel::FT &v, exact_int &num, exact_int &den) {
+    exact_fraction::Decompose()(CGAL::exact(v), num, den);
+}
+
+mpz_srcptr mpz_of(const CGAL::Gmpz &z) { return z.mpz(); }
+#ifdef CGAL_USE_GMPXX
+mpz_srcptr mpz_of(const mpz_class &z) { return z.get_mpz_t(); }
+#endif
+
+std::size_t vertex_size(const gallery_header &header) {
+    return header.coordinates == coordinate_type::rational ? 32 : 16;
+}
+
+std::size_t coordinate_block_size(const gallery_header &header) {
+    return header.vertex_count * vertex_size(header);
+}
+
+/// Checks that the blocks described by the header lie inside the file. Sizes
+/// are compared by division, so counts read from a corrupted file cannot
+/// overflow.
+bool blocks_fit(const gallery_header &h, const char *data,
+                std::size_t length) {
+    if (h.vertex_count > (length - sizeof(gallery_header)) / vertex_size(h))
+        return false;
+    if (!(h.flags & metadata_flag))
+        return true;
+    std::uint64_t offset = h.metadata_offset;
+    if (offset % 8 != 0 || offset < sizeof(gallery_header) ||
+        offset > length || length - offset < sizeof(gallery_metadata))
+        return false;
+    auto m = reinterpret_cast<const gallery_metadata *>(data + offset);
+    std::size_t available = length - offset - sizeof(gallery_metadata);
+    return m->reflex_count <= available / sizeof(std::uint64_t);
+}
+
+mapped_gallery::mapped_gallery(const std::string &filename)
+    : file_(filename) {
+    std::size_t length = file_.size();
+    if (length < sizeof(gallery_header))
+        throw std::runtime_error(filename + " is not a binary gallery");
+
+    const auto &h = header();
+    bool valid = std::memcmp(h.magic, gallery_magic, 4) == 0 &&
+                 h.version == gallery_version &&
+                 h.coordinates <= coordinate_type::rational &&
+                 blocks_fit(h, file_.data(), length);
+    if (!valid)
+        throw std::runtime_error(filename + " is not a binary gallery");
+}
+
+const gallery_header &mapped_gallery::header() const {
+    return *reinterpret_cast<const gallery_header *>(file_.data());
+}
+
+std::size_t mapped_gallery::size() const { return header().vertex_count; }
+
+const void *mapped_gallery::coordinates() const {
+    return file_.data() + sizeof(gallery_header);
+}
+
+const gallery_metadata *mapped_gallery::metadata() const {
+    if (!(header().flags & metadata_flag))
+        return nullptr;
+    return reinterpret_cast<const gallery_metadata *>(
+        file_.data() + header().metadata_offset);
+}
+
+const std::uint64_t *mapped_gallery::reflex_vertices() const {
+    if (!metadata())
+        return nullptr;
+    return reinterpret_cast<const std::uint64_t *>(
+        file_.data() + header().metadata_offset + sizeof(gallery_metadata));
+}
+
+Kernel::FT int64_to_ft(std::int64_t v) {
+    // doubles represent integers up to 2^53 exactly and are much cheaper to
+    // construct than multiprecision numbers
+    const std::int64_t exact_double_limit = std::int64_t(1) << 53;
+    if (v > -exact_double_limit && v < exact_double_limit)
+        return Kernel::FT(static_cast<double>(v));
+    return Kernel::FT(exact_ft(static_cast<long>(v)));
+}
+
+Kernel::FT rational_to_ft(std::int64_t num, std::int64_t den) {
+    if (den == 0)
+        throw std::runtime_error("zero denominator in a binary gallery");
+    if (den == 1)
+        return int64_to_ft(num);
+    return Kernel::FT(exact_ft(static_cast<long>(num)) /
+                      exact_ft(static_cast<long>(den)));
+}
+
+std::vector<Kernel::Point_2> mapped_gallery::points() const {
+    std::vector<Kernel::Point_2> points;
+    std::size_t n = size();
+    points.reserve(n);
+    switch (header().coordinates) {
+    case coordinate_type::int64: {
+        auto c = static_cast<const std::int64_t *>(coordinates());
+        for (std::size_t i = 0; i < n; ++i, c += 2)
+            points.emplace_back(int64_to_ft(c[0]), int64_to_ft(c[1]));
+        break;
+    }
+    case coordinate_type::float64: {
+        auto c = static_cast<const double *>(coordinates());
+        for (std::size_t i = 0; i < n; ++i, c += 2)
+            points.emplace_back(c[0], c[1]);
+        break;
+    }
+    case coordinate_type::rational: {
+        auto c = static_cast<const std::int64_t *>(coordinates());
+        for (std::size_t i = 0; i < n; ++i, c += 4)
+            points.emplace_back(rational_to_ft(c[0], c[1]),
+                                rational_to_ft(c[2], c[3]));
+        break;
+    }
+    }
+    return points;
+}
+
+bool read_pol(std::istream &in, std::vector<Kernel::Point_2> &points) {
+    int n;
+    if (!(in >> n))
+        return false;
+    if (n < 0) {
+        in.setstate(std::ios::failbit);
+        return false;
+    }
+    points.reserve(points.size() + n);
+    for (int i = 0; i < n; ++i) {
+        Kernel::Point_2 p;
+        in >> p;
+        points.push_back(p);
+    }
+    return static_cast<bool>(in);
+}
+
+void write_pol(std::ostream &out,
+               const std::vector<Kernel::Point_2> &points) {
+    out << points.size();
+    for (const auto &p : points) {
+        for (const auto &v : {p.x(), p.y()}) {
+            exact_int num, den;
+            decompose(v, num, den);
+            out << " " << num << "/" << den;
+        }
+    }
+    out << "\n";
+}
+
+bool has_extension(const std::string &filename, const std::string &ext) {
+    return filename.size() >= ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) ==
+               0;
+}
+
+std::vector<Kernel::Point_2> read_gallery(const std::string &filename) {
+    if (has_extension(filename, ".agpb"))
+        return mapped_gallery(filename).points();
+
+    std::ifstream in(filename);
+    std::vector<Kernel::Point_2> points;
+    if (!in || !read_pol(in, points))
+        throw std::runtime_error("cannot read gallery " + filename);
+    return points;
+}
+
+bool fits_int64(const exact_int &z) { return mpz_fits_slong_p(mpz_of(z)); }
+
+bool fits_rational(const Kernel::FT &v) {
+    exact_int num, den;
+    decompose(v, num, den);
+    return fits_int64(num) && fits_int64(den);
+}
+
+coordinate_type
+narrowest_coordinate_type(const std::vector<Kernel::Point_2> &points) {
+    coordinate_type type = coordinate_type::int64;
+    for (const auto &p : points) {
+        for (const auto &v : {p.x(), p.y()}) {
+            if (!fits_rational(v))
+                return coordinate_type::float64;
+            exact_int num, den;
+            decompose(v, num, den);
+            if (den != 1)
+                type = coordinate_type::rational;
+        }
+    }
+    return type;
+}
+
+void append_int64(std::vector<std::int64_t> &block, const exact_int &z) {
+    block.push_back(fits_int64(z)
+                        ? mpz_get_si(mpz_of(z))
+                        : static_cast<std::int64_t>(CGAL::to_double(z)));
+}
+
+gallery_metadata
+compute_metadata(const std::vector<Kernel::Point_2> &points,
+                 std::vector<std::uint64_t> &reflex_vertices) {
+    gallery_metadata m;
+    m.min_x = m.max_x = CGAL::to_double(points[0].x());
+    m.min_y = m.max_y = CGAL::to_double(points[0].y());
+    m.orthogonal = 1;
+    m.counterclockwise =
+        CGAL::orientation_2(points.begin(), points.end()) == CGAL::LEFT_TURN;
+
+    std::size_t n = points.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto &prev = points[(i + n - 1) % n], &curr = points[i],
+                   &next = points[(i + 1) % n];
+        m.min_x = std::min(m.min_x, CGAL::to_double(curr.x()));
+        m.min_y = std::min(m.min_y, CGAL::to_double(curr.y()));
+        m.max_x = std::max(m.max_x, CGAL::to_double(curr.x()));
+        m.max_y = std::max(m.max_y, CGAL::to_double(curr.y()));
+        if (curr.x() != next.x() && curr.y() != next.y())
+            m.orthogonal = 0;
+        auto turn = CGAL::orientation(prev, curr, next);
+        if (turn == (m.counterclockwise ? CGAL::RIGHT_TURN : CGAL::LEFT_TURN))
+            reflex_vertices.push_back(i);
+    }
+    m.reflex_count = reflex_vertices.size();
+    return m;
+}
+
+void write_gallery_binary(const std::string &filename,
+                          const std::vector<Kernel::Point_2> &points,
+                          coordinate_type type, bool with_metadata) {
+    gallery_header header;
+    std::memcpy(header.magic, gallery_magic, 4);
+    header.version = gallery_version;
+    header.coordinates = type;
+    header.flags = with_metadata && !points.empty() ? metadata_flag : 0;
+    header.vertex_count = points.size();
+    header.metadata_offset =
+        header.flags ? sizeof(gallery_header) + coordinate_block_size(header)
+                     : 0;
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("cannot write " + filename);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (type == coordinate_type::float64) {
+        std::vector<double> block;
+        block.reserve(2 * points.size());
+        for (const auto &p : points) {
+            block.push_back(CGAL::to_double(p.x()));
+            block.push_back(CGAL::to_double(p.y()));
+        }
+        out.write(reinterpret_cast<const char *>(block.data()),
+                  block.size() * sizeof(double));
+    } else {
+        std::vector<std::int64_t> block;
+        block.reserve((type == coordinate_type::rational ? 4 : 2) *
+                      points.size());
+        for (const auto &p : points) {
+            for (const auto &v : {p.x(), p.y()}) {
+                exact_int num, den;
+                decompose(v, num, den);
+                if (type == coordinate_type::rational) {
+                    append_int64(block, num);
+                    append_int64(block, den);
+                } else {
+                    append_int64(block, exact_int(num / den));
+                }
+            }
+        }
+        out.write(reinterpret_cast<const char *>(block.data()),
+                  block.size() * sizeof(std::int64_t));
+    }
+
+    if (header.flags & metadata_flag) {
+        std::vector<std::uint64_t> reflex_vertices;
+        gallery_metadata metadata = compute_metadata(points, reflex_vertices);
+        out.write(reinterpret_cast<const char *>(&metadata), sizeof(metadata));
+        out.write(reinterpret_cast<const char *>(reflex_vertices.data()),
+                  reflex_vertices.size() * sizeof(std::uint64_t));
+    }
+    if (!out)
+        throw std::runtime_error("cannot write " + filename);
+}
@@ -0,0 +1,35 @@
+#include <agp/io/mapped_file.h>
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+mapped_file::mapped_file(const std::string &filename)
+    : data_(nullptr), size_(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open " + filename);
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        throw std::runtime_error("cannot read " + filename);
+    }
+    size_ = st.st_size;
+    if (size_ == 0) {
+        close(fd);
+        return;
+    }
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("cannot map " + filename);
+    data_ = static_cast<const char *>(data);
+}
+
+mapped_file::~mapped_file() {
+    if (data_)
+        munmap(const_cast<char *>(data_), size_);
+}
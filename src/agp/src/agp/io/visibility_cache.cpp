@@ -0,0 +1,149 @@
+#include <agp/io/mapped_file.h>
+#include <agp/io/visibility_cache.h>
+
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+const std::string cache_header = "AGPVIS 1";
+
+static std::string &cache_directory() {
+    static std::string directory;
+    return directory;
+}
+
+void set_visibility_cache_directory(const std::string &directory) {
+    cache_directory() = directory;
+}
+
+const std::string &visibility_cache_directory() { return cache_directory(); }
+
+std::uint64_t polygon_hash(const std::vector<Kernel::Point_2> &vertices) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    std::ostringstream s;
+    for (const auto &v : vertices) {
+        s.str("");
+        s << CGAL::exact(v.x()) << " " << CGAL::exact(v.y()) << ";";
+        for (char c : s.str()) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+static std::string
+cache_filename(const std::vector<Kernel::Point_2> &vertices) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.vis",
+                  static_cast<unsigned long long>(polygon_hash(vertices)));
+    return cache_directory() + "/" + name;
+}
+
+static void write_points(const std::vector<Kernel::Point_2> &points,
+                         std::ostream &out) {
+    out << points.size() << "\n";
+    for (const auto &p : points) {
+        out << CGAL::exact(p.x()) << " " << CGAL::exact(p.y()) << "\n";
+    }
+}
+
+static bool read_points(std::istream &in,
+                        std::vector<Kernel::Point_2> &points) {
+    unsigned long n;
+    if (!(in >> n))
+        return false;
+    points.reserve(n);
+    for (unsigned long i = 0; i < n; ++i) {
+        Kernel::Point_2 p;
+        in >> p;
+        points.push_back(p);
+    }
+    return static_cast<bool>(in);
+}
+
+static std::vector<Kernel::Point_2>
+region_boundary(const Arrangement_2 &region) {
+    auto f = region.faces_begin();
+    while (f->is_unbounded())
+        ++f;
+    return face_vertices(f);
+}
+
+static bool read_cache(const std::string &filename,
+                       const std::vector<Kernel::Point_2> &vertices,
+                       std::vector<Arrangement_2> &regions) {
+    if (access(filename.c_str(), R_OK) != 0)
+        return false;
+    try {
+        mapped_file file(filename);
+        memory_streambuf buffer(file.data(), file.size());
+        std::istream in(&buffer);
+
+        std::string header;
+        std::getline(in, header);
+        std::vector<Kernel::Point_2> cached_vertices;
+        if (header != cache_header || !read_points(in, cached_vertices) ||
+            cached_vertices != vertices)
+            return false;
+
+        // regions are built in place, arrangements can't be moved
+        regions.resize(vertices.size());
+        for (unsigned long i = 0; i < vertices.size(); ++i) {
+            std::vector<Kernel::Point_2> boundary;
+            if (!read_points(in, boundary)) {
+                regions.clear();
+                return false;
+            }
+            insert_polygon(regions[i], boundary.begin(), boundary.end());
+        }
+    } catch (const std::exception &) {
+        regions.clear();
+        return false;
+    }
+    return true;
+}
+
+static void write_cache(const std::string &filename,
+                        const std::vector<Kernel::Point_2> &vertices,
+                        const std::vector<Arrangement_2> &regions) {
+    // written under a temporary name and renamed, so that concurrent runs
+    // never read a partially written file, the name is unique per thread as
+    // algorithms of a portfolio can write the same entry
+    std::size_t thread =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+    std::string tmp_filename = filename + ".tmp" +
+                               std::to_string(static_cast<long>(getpid())) +
+                               "." + std::to_string(thread);
+    std::ofstream out(tmp_filename);
+    if (!out)
+        return;
+    out << cache_header << "\n";
+    write_points(vertices, out);
+    for (const auto &region : regions) {
+        write_points(region_boundary(region), out);
+    }
+    out.close();
+    if (!out || std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        std::remove(tmp_filename.c_str());
+}
+
+std::vector<Arrangement_2>
+cached_visibility_regions(const Arrangement_2 &polygon,
+                          const std::vector<Kernel::Point_2> &vertices) {
+    if (cache_directory().empty())
+        return all_visibility_regions(polygon, vertices);
+
+    std::string filename = cache_filename(vertices);
+    std::vector<Arrangement_2> regions;
+    if (read_cache(filename, vertices, regions))
+        return regions;
+
+    regions = all_visibility_regions(polygon, vertices);
+    write_cache(filename, vertices, regions);
+    return regions;
+}
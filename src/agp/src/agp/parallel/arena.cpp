@@ -0,0 +1,67 @@
+#include <agp/parallel/arena.h>
+
+#include <algorithm>
+
+constexpr std::size_t arena_alignment = alignof(std::max_align_t);
+
+arena::arena(std::size_t block_size) : block_size_(block_size) {}
+
+arena::~arena() {
+    for (auto &b : blocks_)
+        ::operator delete(b.data);
+}
+
+void *arena::allocate(std::size_t bytes) {
+    bytes = (bytes + arena_alignment - 1) / arena_alignment * arena_alignment;
+    if (!blocks_.empty() && offset_ + bytes <= blocks_[current_].size) {
+        void *p = blocks_[current_].data + offset_;
+        offset_ += bytes;
+        return p;
+    }
+
+    // Move to the next block that is large enough, blocks left behind stay
+    // unused until the arena is rewound.
+    std::size_t next = blocks_.empty() ? 0 : current_ + 1;
+    while (next < blocks_.size() && blocks_[next].size < bytes)
+        ++next;
+    if (next == blocks_.size()) {
+        std::size_t size = std::max(block_size_, bytes);
+        blocks_.push_back({static_cast<char *>(::operator new(size)), size});
+    }
+    current_ = next;
+    offset_ = bytes;
+    return blocks_[current_].data;
+}
+
+void arena::rewind(const marker &position) {
+    current_ = position.block;
+    offset_ = position.offset;
+}
+
+std::size_t arena::capacity() const {
+    std::size_t total = 0;
+    for (const auto &b : blocks_)
+        total += b.size;
+    return total;
+}
+
+static thread_local arena *active_arena = nullptr;
+
+arena *current_arena() { return active_arena; }
+
+/// Arena of the calling thread, created when the thread opens its first
+/// scope.
+static arena &thread_arena() {
+    static thread_local arena instance;
+    return instance;
+}
+
+arena_scope::arena_scope()
+    : previous_(active_arena), start_(thread_arena().mark()) {
+    active_arena = &thread_arena();
+}
+
+arena_scope::~arena_scope() {
+    thread_arena().rewind(start_);
+    active_arena = previous_;
+}
@@ -0,0 +1,180 @@
+#include <agp/parallel/thread_pool.h>
+
+#include <atomic>
+#include <iterator>
+
+/// Pool and queue of the worker running on this thread, if any.
+static thread_local thread_pool *current_pool = nullptr;
+static thread_local std::size_t current_queue = 0;
+
+/// Context of the code running on this thread: every running task has its
+/// own, other threads get one on their first submit. 0 until assigned.
+static thread_local std::size_t current_context = 0;
+static std::atomic<std::size_t> next_context(1);
+
+/// @return context of the calling thread, assigned on first use
+static std::size_t own_context() {
+    if (current_context == 0)
+        current_context = next_context++;
+    return current_context;
+}
+
+thread_pool::thread_pool(unsigned workers) {
+    workers = std::max(1u, workers);
+    for (unsigned i = 0; i < workers; ++i)
+        queues_.push_back(std::make_unique<task_queue>());
+    for (unsigned i = 0; i < workers; ++i)
+        threads_.emplace_back(&thread_pool::work, this, i);
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        reserved_ = 0;
+    }
+    wake_.notify_all();
+    for (auto &t : threads_)
+        t.join();
+}
+
+void thread_pool::push(std::function<void()> f) {
+    task t;
+    t.run = std::move(f);
+    t.owner = own_context();
+    std::size_t index;
+    if (current_pool == this) {
+        index = current_queue;
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index = next_queue_++ % queues_.size();
+    }
+    {
+        // pending_ is raised before the queue lock is released, so a thief
+        // cannot take the task and lower it first
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(t));
+        std::lock_guard<std::mutex> pending_lock(mutex_);
+        ++pending_;
+    }
+    // all idle workers check the task, a single notification may go to a
+    // worker that is not allowed to run it yet
+    wake_.notify_all();
+}
+
+bool thread_pool::pop(task &t, std::size_t home, bool own) {
+    std::size_t owner = own ? own_context() : 0;
+    auto matches = [owner](const task &c) {
+        return owner == 0 || c.owner == owner;
+    };
+    std::size_t n = queues_.size();
+    for (std::size_t k = 0; k < n; ++k) {
+        auto &queue = *queues_[(home + k) % n];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        // The owner takes the newest task, thieves take the oldest one.
+        auto it = queue.tasks.end();
+        if (k == 0 && current_pool == this) {
+            auto r = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(),
+                                  matches);
+            if (r != queue.tasks.rend())
+                it = std::prev(r.base());
+        } else {
+            it = std::find_if(queue.tasks.begin(), queue.tasks.end(),
+                              matches);
+        }
+        if (it == queue.tasks.end())
+            continue;
+        t = std::move(*it);
+        queue.tasks.erase(it);
+        std::lock_guard<std::mutex> pending_lock(mutex_);
+        --pending_;
+        return true;
+    }
+    return false;
+}
+
+void thread_pool::execute(task &t) {
+    // Tasks submitted by t belong to this run of t alone.
+    std::size_t outer = current_context;
+    current_context = next_context++;
+    t.run();
+    current_context = outer;
+}
+
+bool thread_pool::is_worker() const { return current_pool == this; }
+
+bool thread_pool::run_pending_task() {
+    // Only the caller's own tasks, a task of someone else may be a solver job
+    // that outlasts the wait by far.
+    task t;
+    std::size_t home = current_pool == this ? current_queue : 0;
+    if (!pop(t, home, true))
+        return false;
+    execute(t);
+    return true;
+}
+
+void thread_pool::work(std::size_t index) {
+    current_pool = this;
+    current_queue = index;
+    while (true) {
+        {
+            // Workers running tasks and reserved workers never together
+            // exceed the size of the pool.
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] {
+                return stop_ ||
+                       (pending_ > 0 && active_ + reserved_ < size());
+            });
+            if (stop_ && pending_ == 0)
+                return;
+            ++active_;
+        }
+        task t;
+        if (pop(t, index, false))
+            execute(t);
+        std::lock_guard<std::mutex> lock(mutex_);
+        --active_;
+    }
+}
+
+unsigned thread_pool::reserve(unsigned workers) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    unsigned idle = size() - reserved_ - active_;
+    unsigned granted = std::min(workers, idle);
+    reserved_ += granted;
+    return granted;
+}
+
+void thread_pool::release(unsigned workers) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reserved_ -= std::min(workers, reserved_);
+    }
+    wake_.notify_all();
+}
+
+static std::mutex default_pool_mutex;
+static std::unique_ptr<thread_pool> default_pool;
+static unsigned configured_threads = 0;
+
+void set_thread_count(unsigned threads) {
+    std::lock_guard<std::mutex> lock(default_pool_mutex);
+    configured_threads = threads;
+    default_pool.reset();
+}
+
+unsigned thread_count() {
+    std::lock_guard<std::mutex> lock(default_pool_mutex);
+    if (configured_threads)
+        return configured_threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+thread_pool &default_thread_pool() {
+    unsigned threads = thread_count();
+    std::lock_guard<std::mutex> lock(default_pool_mutex);
+    if (!default_pool)
+        default_pool = std::make_unique<thread_pool>(threads - 1);
+    return *default_pool;
+}
@@ -1,9 +1,13 @@
 #include <agp/plot/agp_plot.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
 void print_points(const std::vector<Kernel::Point_2> &points,
                   std::ostream &out) {
     for (const auto &p : points) {
-        out << p << std::endl;
+        out << p << "\n";
     }
 }
 
@@ -36,3 +40,77 @@ void print_region(const Arrangement_2 &region, std::ostream &out) {
         out << v->point() << "\n";
     }
 }
+
+result_writer::result_writer(std::ostream &out, int precision, bool exact,
+                             std::size_t buffer_size)
+    : out_(out), buffer_size_(buffer_size),
+      precision_(std::min(std::max(precision, 1), 17)),
+      exact_(exact) {
+    buffer_.reserve(buffer_size_);
+}
+
+result_writer::~result_writer() { flush(); }
+
+void result_writer::flush() {
+    out_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+}
+
+void result_writer::reserve() {
+    if (buffer_.size() >= buffer_size_)
+        flush();
+}
+
+void result_writer::number(const Kernel::FT &v) {
+    if (exact_) {
+        std::ostringstream s;
+        s << CGAL::exact(v);
+        buffer_ += s.str();
+        return;
+    }
+    // 17 digits, sign, point and exponent fit with room to spare
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.*g", precision_,
+                               CGAL::to_double(v));
+    buffer_.append(digits, length);
+}
+
+void result_writer::point(const Kernel::Point_2 &p) {
+    number(p.x());
+    buffer_ += ' ';
+    number(p.y());
+}
+
+void result_writer::polygon(const std::vector<Kernel::Point_2> &polygon) {
+    buffer_ += "pol " + std::to_string(polygon.size()) + "\n";
+    for (const auto &p : polygon) {
+        point(p);
+        buffer_ += '\n';
+        reserve();
+    }
+}
+
+void result_writer::guards(const std::vector<Kernel::Point_2> &guards) {
+    for (const auto &g : guards) {
+        buffer_ += "grd ";
+        point(g);
+        buffer_ += '\n';
+        reserve();
+    }
+}
+
+void result_writer::region(const Arrangement_2 &region) {
+    auto f = region.faces_begin();
+    while (f != region.faces_end() && f->is_unbounded())
+        ++f;
+    if (f == region.faces_end())
+        return;
+    auto circ = f->outer_ccb(), curr = circ;
+    std::size_t size = CGAL::circulator_size(circ);
+    buffer_ += "rgn " + std::to_string(size) + "\n";
+    do {
+        point(curr->target()->point());
+        buffer_ += '\n';
+        reserve();
+    } while (++curr != circ);
+}
@@ -0,0 +1,40 @@
+#include <agp/profile/memory.h>
+
+#include <cstdio>
+
+#include <malloc.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+std::size_t heap_in_use() {
+#if defined(__GLIBC__) &&                                                      \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return static_cast<unsigned>(info.uordblks) +
+           static_cast<unsigned>(info.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+std::size_t resident_memory() {
+    FILE *f = std::fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    unsigned long size = 0, resident = 0;
+    if (std::fscanf(f, "%lu %lu", &size, &resident) != 2)
+        resident = 0;
+    std::fclose(f);
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::size_t peak_resident_memory() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    // Linux reports the value in kilobytes.
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+}
@@ -0,0 +1,167 @@
+#include <agp/profile/profiler.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+std::atomic<bool> profiling_flag(false);
+std::atomic<bool> heap_profiling_flag(false);
+
+using clock_type = std::chrono::steady_clock;
+
+struct trace_event {
+    const char *name;
+    double start;    // microseconds since the start of the profile
+    double duration; // microseconds
+    unsigned thread;
+    bool heap_sampled;    // whether the heap was measured
+    long long heap_delta; // bytes allocated and not released in the scope
+    std::size_t heap;     // heap size at the end of the scope
+};
+
+struct timer_summary {
+    unsigned long long calls = 0;
+    double total = 0; // seconds
+    long long heap_delta = 0;
+    std::size_t peak_heap = 0;
+};
+
+struct profile_data {
+    std::mutex mutex;
+    clock_type::time_point epoch = clock_type::now();
+    std::vector<trace_event> events;
+    std::map<std::string, timer_summary> timers;
+    std::map<std::string, long long> counters;
+    std::map<std::string, long long> maximums;
+};
+
+profile_data &profile() {
+    static profile_data data;
+    return data;
+}
+
+/// Small sequential thread ids, which trace viewers display nicely.
+unsigned thread_index() {
+    static std::atomic<unsigned> next(0);
+    thread_local unsigned index = next++;
+    return index;
+}
+
+void set_profiling(bool enabled) {
+    profiling_flag.store(enabled, std::memory_order_relaxed);
+}
+
+void set_heap_profiling(bool enabled) {
+    heap_profiling_flag.store(enabled, std::memory_order_relaxed);
+}
+
+void reset_profile() {
+    auto &data = profile();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.epoch = clock_type::now();
+    data.events.clear();
+    data.timers.clear();
+    data.counters.clear();
+    data.maximums.clear();
+}
+
+void add_to_counter(const char *name, long long value) {
+    if (!profiling_enabled())
+        return;
+    auto &data = profile();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.counters[name] += value;
+}
+
+void record_maximum(const char *name, long long value) {
+    if (!profiling_enabled())
+        return;
+    auto &data = profile();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    auto it = data.maximums.find(name);
+    if (it == data.maximums.end())
+        data.maximums.emplace(name, value);
+    else
+        it->second = std::max(it->second, value);
+}
+
+scoped_timer::~scoped_timer() {
+    if (!name_)
+        return;
+    auto end = clock_type::now();
+    std::size_t heap = sample_heap_ ? heap_in_use() : 0;
+    long long heap_delta =
+        static_cast<long long>(heap) - static_cast<long long>(heap_);
+    auto &data = profile();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    std::chrono::duration<double, std::micro> start = start_ - data.epoch,
+                                              duration = end - start_;
+    data.events.push_back({name_, start.count(), duration.count(),
+                           thread_index(), sample_heap_, heap_delta, heap});
+    auto &summary = data.timers[name_];
+    ++summary.calls;
+    summary.total += duration.count() / 1e6;
+    summary.heap_delta += heap_delta;
+    summary.peak_heap = std::max(summary.peak_heap, heap);
+}
+
+void write_profile_json(std::ostream &out) {
+    auto &data = profile();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    out << "{\"timers\":{";
+    const char *separator = "";
+    for (const auto &timer : data.timers) {
+        out << separator << "\"" << timer.first << "\":{\"calls\":"
+            << timer.second.calls << ",\"total\":" << timer.second.total
+            << ",\"heap_delta\":" << timer.second.heap_delta
+            << ",\"peak_heap\":" << timer.second.peak_heap << "}";
+        separator = ",";
+    }
+    out << "},\"counters\":{";
+    separator = "";
+    for (const auto &counter : data.counters) {
+        out << separator << "\"" << counter.first << "\":" << counter.second;
+        separator = ",";
+    }
+    out << "},\"maximums\":{";
+    separator = "";
+    for (const auto &maximum : data.maximums) {
+        out << separator << "\"" << maximum.first << "\":" << maximum.second;
+        separator = ",";
+    }
+    out << "},\"peak_resident_memory\":" << peak_resident_memory() << "}\n";
+}
+
+void write_chrome_trace(std::ostream &out) {
+    auto &data = profile();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    out << "{\"traceEvents\":[";
+    double last = 0;
+    const char *separator = "\n";
+    for (const auto &e : data.events) {
+        out << separator << "{\"name\":\"" << e.name
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+            << ",\"ts\":" << e.start << ",\"dur\":" << e.duration;
+        if (e.heap_sampled) {
+            out << ",\"args\":{\"heap_delta\":" << e.heap_delta << "}}";
+            out << ",\n{\"name\":\"heap\",\"ph\":\"C\",\"pid\":1,\"ts\":"
+                << e.start + e.duration << ",\"args\":{\"bytes\":" << e.heap
+                << "}}";
+        } else {
+            out << "}";
+        }
+        separator = ",\n";
+        last = std::max(last, e.start + e.duration);
+    }
+    for (const auto *values : {&data.counters, &data.maximums}) {
+        for (const auto &counter : *values) {
+            out << separator << "{\"name\":\"" << counter.first
+                << "\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << last
+                << ",\"args\":{\"value\":" << counter.second << "}}";
+            separator = ",\n";
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
@@ -2,57 +2,260 @@
 #include <agp/algo/couto_algorithm.h>
 #include <agp/algo/fisk_algorithm.h>
 #include <agp/algo/ghosh_algorithm.h>
+#include <agp/algo/multi_resolution.h>
+#include <agp/algo/portfolio.h>
+#include <agp/arrangement/orthogonal.h>
 #include <agp/arrangement/utils.h>
 #include <agp/arrangement/visibility.h>
 #include <agp/discretization_methods.h>
 #include <agp/initial_placements.h>
+#include <agp/io/gallery_io.h>
+#include <agp/io/visibility_cache.h>
+#include <agp/parallel/thread_pool.h>
+#include <agp/plot/agp_plot.h>
 
+#include <CGAL/Polygon_2_algorithms.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
 #include <string>
 
-std::vector<std::string> alg_flags = {"-fisk", "-ghosh", "-couto",
-                                      "-baumgartner"};
+std::vector<std::string> alg_flags = {
+    "-fisk",         "-ghosh",        "-couto",       "-couto-grid",
+    "-couto-shadow", "-couto-reflex", "-baumgartner", "-portfolio",
+    "-multi-couto",  "-multi-baumgartner"};
+
+/// Initial placement of -baumgartner, see \ref placement_by_name.
+placement_method placement = every_second;
+
+/// Tolerance of the simplified gallery of -multi-couto and
+/// -multi-baumgartner, see \ref simplify_polygon.
+Kernel::FT tolerance = 0;
 
 void instruction() {
-    std::cerr << "./main in_filename algorithm [out_filename]\nAvailable "
+    std::cerr << "./main in_filename algorithm [out_filename] [-precision "
+                 "digits] [-exact] [-cache dir] [-threads n]\n"
+                 "    [-placement every_second|reflex|convex|chords] "
+                 "[-tolerance distance]\n"
+                 "./main -batch algorithm [in_filename]\nAvailable "
                  "algorithm flags ";
     for (const auto &flag : alg_flags)
         std::cerr << flag << " ";
     std::cerr << "\n";
 }
 
+/// Appends visibility regions of guards placed anywhere in the polygon.
+void point_guard_regions(const std::vector<Kernel::Point_2> &points,
+                         const std::vector<Kernel::Point_2> &guards,
+                         std::vector<Arrangement_2> &guard_regions) {
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    guard_regions.reserve(guard_regions.size() + guards.size());
+    for (const auto &g : guards) {
+        guard_regions.emplace_back();
+        general_point_visibility_region(polygon, g, guard_regions.back());
+    }
+}
+
+/// Finds guards with the algorithm of the given flag. If lower_bound is not
+/// null, it receives the best lower bound proven by the algorithm, or 0 if
+/// the algorithm proves none.
 std::vector<Kernel::Point_2>
 find_guards(const std::vector<Kernel::Point_2> &points,
-            const std::string &alg_name) {
+            const std::string &alg_name, IloEnv &env,
+            std::vector<Arrangement_2> *guard_regions = nullptr,
+            unsigned long *lower_bound = nullptr) {
+    progress_callback progress;
+    if (lower_bound) {
+        *lower_bound = 0;
+        progress = [lower_bound](const iteration_progress &state) {
+            *lower_bound = std::max(*lower_bound, state.lower_bound);
+            return true;
+        };
+    }
+
     if (alg_name == "-ghosh")
-        return ghosh_algorithm(points);
+        return ghosh_algorithm(points, guard_regions);
     else if (alg_name == "-couto")
-        return couto_algorithm(points, all_vertices);
+        return couto_algorithm(env, points, all_vertices, 0, nullptr,
+                               guard_regions, progress);
+    else if (alg_name == "-couto-grid")
+        return couto_algorithm(env, points, orthogonal_grid, 0, nullptr,
+                               guard_regions, progress);
+    else if (alg_name == "-couto-shadow")
+        return couto_algorithm(env, points, shadow_avp, 0, nullptr,
+                               guard_regions, progress);
+    else if (alg_name == "-couto-reflex")
+        return couto_algorithm(env, points, reflex_extension, 0, nullptr,
+                               guard_regions, progress);
     else if (alg_name == "-baumgartner")
-        return baumgartner_algorithm(points, every_second, 120);
+        return baumgartner_algorithm(env, points, placement, 120, 0,
+                                     nullptr, guard_regions, progress);
     else if (alg_name == "-fisk")
         return fisk_algorithm(points);
-    else {
+    else if (alg_name == "-portfolio") {
+        portfolio_options options;
+        options.time_limit = 120;
+        auto result = portfolio_algorithm(points, options);
+        std::cerr << "portfolio: " << result.algorithm << ", lower bound "
+                  << result.lower_bound
+                  << (result.optimal ? ", optimal\n" : "\n");
+        if (lower_bound)
+            *lower_bound = result.lower_bound;
+        if (guard_regions)
+            point_guard_regions(points, result.guards, *guard_regions);
+        return result.guards;
+    } else if (alg_name == "-multi-couto" ||
+               alg_name == "-multi-baumgartner") {
+        multi_resolution_options options;
+        options.tolerance = tolerance;
+        options.vertex_guards = alg_name == "-multi-couto";
+        options.sec = 120;
+        options.progress = progress;
+        auto guards = multi_resolution_algorithm(points, options);
+        if (guard_regions)
+            point_guard_regions(points, guards, *guard_regions);
+        return guards;
+    } else {
         instruction();
         exit(-1);
     }
 }
 
-void process(const std::string &algorithm,
-             const std::vector<Kernel::Point_2> &points, std::ostream &out) {
+/// Visibility regions of guards placed in vertices, computed in one pass over
+/// the polygon.
+std::vector<Arrangement_2>
+vertex_guard_regions(const std::vector<Kernel::Point_2> &points,
+                     const std::vector<Kernel::Point_2> &guards) {
     auto polygon = create_arrangement<Arrangement_2>(points);
+    auto regions = all_visibility_regions(polygon, points);
+    std::map<Kernel::Point_2, unsigned long> index;
+    for (unsigned long i = 0; i < points.size(); ++i)
+        index[points[i]] = i;
+    std::vector<Arrangement_2> guard_regions;
+    for (const auto &g : guards)
+        guard_regions.push_back(regions[index[g]]);
+    return guard_regions;
+}
+
+void process(const std::string &algorithm,
+             const std::vector<Kernel::Point_2> &points, std::ostream &out,
+             int precision, bool exact) {
     if (algorithm == "-fisk-arr") {
         auto output = fisk_arrangement(points);
         plot_fisk(output, out);
     } else {
-        auto guards = find_guards(points, algorithm);
-        print_polygon(points, out);
-        print_guards(guards, out);
-        for (const auto &g : guards) {
-            print_region(general_point_visibility_region(polygon, g), out);
+        IloEnv env;
+        std::vector<Arrangement_2> regions;
+        auto guards = find_guards(points, algorithm, env, &regions);
+        env.end();
+        if (regions.size() != guards.size())
+            regions = vertex_guard_regions(points, guards);
+
+        result_writer writer(out, precision, exact);
+        writer.polygon(points);
+        writer.guards(guards);
+        for (const auto &r : regions) {
+            writer.region(r);
+        }
+    }
+}
+
+std::string json_escape(const std::string &s) {
+    std::string escaped;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[7];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
         }
     }
+    return escaped;
+}
+
+/// Writes the result of one gallery of a batch. The guards are an upper bound
+/// on the optimum of the problem solved by the algorithm (vertex guards for
+/// Couto's algorithm, point guards for the others), together with Chvatal's
+/// bound n/3, or n/4 for orthogonal galleries. The lower bound is written
+/// only if the algorithm proved one.
+void print_json_result(unsigned long instance,
+                       const std::vector<Kernel::Point_2> &points,
+                       const std::vector<Kernel::Point_2> &guards,
+                       unsigned long lower_bound, double time,
+                       std::ostream &out) {
+    unsigned long upper_bound = guard_upper_bound(points);
+    if (!guards.empty())
+        upper_bound = std::min<unsigned long>(upper_bound, guards.size());
+    out << "{\"instance\":" << instance
+        << ",\"vertices\":" << points.size()
+        << ",\"guard_count\":" << guards.size();
+    if (lower_bound)
+        out << ",\"lower_bound\":" << lower_bound;
+    out << ",\"upper_bound\":" << upper_bound << ",\"time\":" << time
+        << ",\"guards\":[";
+    for (unsigned long i = 0; i < guards.size(); ++i) {
+        out << (i ? ",[" : "[") << CGAL::to_double(guards[i].x()) << ","
+            << CGAL::to_double(guards[i].y()) << "]";
+    }
+    out << "]}\n";
+}
+
+void print_json_error(unsigned long instance, const std::string &message,
+                      std::ostream &out) {
+    out << "{\"instance\":" << instance << ",\"error\":\""
+        << json_escape(message) << "\"}\n";
+}
+
+/// Solves galleries read one after another from the stream and writes one
+/// JSON line per gallery. One CPLEX environment is shared by all the
+/// instances. A gallery that cannot be read or solved gets an error line,
+/// the rest of its line is skipped and the batch goes on with the next one.
+void process_batch(const std::string &algorithm, std::istream &in,
+                   std::ostream &out) {
+    IloEnv env;
+    out << std::setprecision(17);
+    for (unsigned long instance = 0; !(in >> std::ws).eof(); ++instance) {
+        try {
+            std::vector<Kernel::Point_2> points;
+            if (!read_pol(in, points))
+                throw std::runtime_error("malformed gallery");
+            if (points.size() < 3 ||
+                !CGAL::is_simple_2(points.begin(), points.end(), Kernel()))
+                throw std::runtime_error("gallery is not a simple polygon");
+            unsigned long lower_bound;
+            auto t1 = std::chrono::high_resolution_clock::now();
+            auto guards =
+                find_guards(points, algorithm, env, nullptr, &lower_bound);
+            auto t2 = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double> time_span = t2 - t1;
+            print_json_result(instance, points, guards, lower_bound,
+                              time_span.count(), out);
+        } catch (const IloException &e) {
+            print_json_error(instance, e.getMessage(), out);
+        } catch (const std::exception &e) {
+            print_json_error(instance, e.what(), out);
+        } catch (...) {
+            print_json_error(instance, "unknown error", out);
+        }
+        if (!in) {
+            in.clear();
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        out.flush();
+    }
+    env.end();
 }
 
 int main(int argc, char *argv[]) {
@@ -61,33 +264,75 @@ int main(int argc, char *argv[]) {
         exit(-1);
     }
 
+    if (std::string(argv[1]) == "-batch") {
+        std::string algorithm = argv[2];
+        if (std::find(alg_flags.begin(), alg_flags.end(), algorithm) ==
+            alg_flags.end()) {
+            instruction();
+            exit(-1);
+        }
+        if (argc > 3) {
+            std::ifstream in(argv[3]);
+            if (!in) {
+                std::cerr << "No such file: " << argv[3] << std::endl;
+                exit(-1);
+            }
+            process_batch(algorithm, in, std::cout);
+        } else {
+            process_batch(algorithm, std::cin, std::cout);
+        }
+        return 0;
+    }
+
     std::string in_filename = argv[1], algorithm = argv[2];
-    std::ifstream in(in_filename);
     std::vector<Kernel::Point_2> points;
 
-    if (!in) {
-        std::cerr << "No such file: " << in_filename << std::endl;
+    /// Read the gallery, .agpb files are read as binary galleries
+    try {
+        points = read_gallery(in_filename);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
         exit(-1);
     }
 
-    /// Read the gallery
-    int n;
-    in >> n;
-    for (int i = 0; i < n; ++i) {
-        Kernel::Point_2 p;
-        in >> p;
-        points.push_back(p);
+    std::string out_filename;
+    int precision = 6;
+    bool exact = false;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-precision" && i + 1 < argc)
+            precision = std::min(std::max(std::stoi(argv[++i]), 1), 17);
+        else if (arg == "-exact")
+            exact = true;
+        else if (arg == "-cache" && i + 1 < argc)
+            set_visibility_cache_directory(argv[++i]);
+        else if (arg == "-threads" && i + 1 < argc)
+            set_thread_count(std::stoul(argv[++i]));
+        else if (arg == "-placement" && i + 1 < argc) {
+            try {
+                placement = placement_by_name(argv[++i]);
+            } catch (const std::invalid_argument &e) {
+                std::cerr << e.what() << std::endl;
+                exit(-1);
+            }
+        } else if (arg == "-tolerance" && i + 1 < argc)
+            tolerance = std::stod(argv[++i]);
+        else if (out_filename.empty() && arg[0] != '-')
+            out_filename = arg;
+        else {
+            instruction();
+            exit(-1);
+        }
     }
 
     /// Solve the problem for the gallery and save the result in a file or print
     /// to std::cout
-    if (argc > 3) {
-        std::string out_filename = argv[3];
+    if (!out_filename.empty()) {
         std::ofstream out(out_filename);
-        process(algorithm, points, out);
+        process(algorithm, points, out, precision, exact);
         out.close();
     } else {
-        process(algorithm, points, std::cout);
+        process(algorithm, points, std::cout, precision, exact);
     }
 
     return 0;
@@ -0,0 +1,46 @@
+#include <agp/io/gallery_io.h>
+
+#include <iostream>
+#include <string>
+
+void instruction() {
+    std::cerr << "./pol2bin in_filename out_filename [-double] "
+                 "[-no-metadata]\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        instruction();
+        exit(-1);
+    }
+
+    std::string in_filename = argv[1], out_filename = argv[2];
+    bool force_double = false, with_metadata = true;
+    for (int i = 3; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "-double")
+            force_double = true;
+        else if (flag == "-no-metadata")
+            with_metadata = false;
+        else {
+            instruction();
+            exit(-1);
+        }
+    }
+
+    try {
+        auto points = read_gallery(in_filename);
+        auto type = force_double ? coordinate_type::float64
+                                 : narrowest_coordinate_type(points);
+        if (type == coordinate_type::float64 && !force_double) {
+            std::cerr << "Coordinates do not fit in int64 values, they will "
+                         "be rounded to doubles.\n";
+        }
+        write_gallery_binary(out_filename, points, type, with_metadata);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        exit(-1);
+    }
+
+    return 0;
+}
@@ -1,30 +1,51 @@
+#include <algorithm>
 
 #include <chrono>
 #include <functional>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include <agp/algo/baumgartner_algorithm.h>
 #include <agp/algo/couto_algorithm.h>
 #include <agp/algo/fisk_algorithm.h>
 #include <agp/algo/ghosh_algorithm.h>
+#include <agp/algo/portfolio.h>
+#include <agp/arrangement/verification.h>
 #include <agp/discretization_methods.h>
 #include <agp/initial_placements.h>
+#include <agp/io/gallery_io.h>
+#include <agp/io/visibility_cache.h>
+#include <agp/parallel/thread_pool.h>
+#include <agp/profile/profiler.h>
 
 #include <dirent.h>
 
+#include "outcome.h"
+#include "scheduler.h"
+
 void instruction(const std::string &message = "") {
     if (!message.empty()) {
         std::cerr << "ERROR: " << message << "\n";
     }
     std::vector<std::string> alg_flags = {"-fisk", "-ghosh", "-couto",
-                                          "-baumgartner"};
+                                          "-baumgartner", "-portfolio"};
     std::cerr << "./main [instances_dir] [algorithm_flag] "
-                 "[output_file]\nAvailable algorithm flags ";
+                 "[output_file] [-compact iterations] [-cache dir]\n"
+                 "    [-j workers] [-timeout seconds] [-memory MB] [-resume]\n"
+                 "    [-profile dir] [-profile-heap] [-convergence dir] "
+                 "[-no-verify]\n"
+                 "    [-budget MB] [-threads n] [-placement name]\n"
+                 "Available algorithm flags ";
     for (const auto &flag : alg_flags)
         std::cerr << flag << " ";
-    std::cerr << "\n";
+    std::cerr << "\nInitial placements of -baumgartner: every_second (default) "
+                 "reflex convex chords\n";
 }
 
 std::vector<std::string> read_directory(const std::string &name) {
@@ -45,14 +66,7 @@ std::vector<std::string> read_directory(const std::string &name) {
 
 void test_case(const std::string &filename,
                std::vector<Kernel::Point_2> &points) {
-    std::ifstream in(filename);
-    int n;
-    in >> n;
-    for (int i = 0; i < n; ++i) {
-        Kernel::Point_2 p;
-        in >> p;
-        points.push_back(p);
-    }
+    points = read_gallery(filename);
 }
 
 void output_results(const std::map<unsigned, double> &times,
@@ -62,64 +76,197 @@ void output_results(const std::map<unsigned, double> &times,
     }
 }
 
+/*! \struct experiment_settings
+ * Settings applied to every instance of an experiment.
+ */
+struct experiment_settings {
+    unsigned compaction_interval = 0; /*!< see \ref compaction.h */
+    std::string profile_dir;     /*!< directory for profiles, empty if none */
+    bool profile_heap = false;   /*!< measure the heap in every profiled
+                                  * scope */
+    std::string convergence_dir; /*!< directory for convergence traces */
+    bool verify = true;          /*!< check that the guards cover the polygon */
+    std::size_t memory_budget = 0; /*!< bytes after which the algorithm is
+                                    * stopped, 0 means no budget */
+    std::string placement = "every_second"; /*!< initial placement of
+                                             * \ref baumgartner_algorithm */
+};
+
 std::vector<Kernel::Point_2> find_guards(std::vector<Kernel::Point_2> &points,
-                                         const std::string &alg_name) {
+                                         const std::string &alg_name,
+                                         const experiment_settings &settings,
+                                         compaction_stats &stats,
+                                         const progress_callback &progress) {
     if (alg_name == "-ghosh")
         return ghosh_algorithm(points);
     else if (alg_name == "-couto")
-        return couto_algorithm(points, all_vertices);
+        return couto_algorithm(points, all_vertices,
+                               settings.compaction_interval, &stats, nullptr,
+                               progress);
     else if (alg_name == "-baumgartner")
-        return baumgartner_algorithm(points, every_second, 300);
+        return baumgartner_algorithm(
+            points, placement_by_name(settings.placement), 300,
+            settings.compaction_interval, &stats, nullptr, progress);
     else if (alg_name == "-fisk")
         return fisk_algorithm(points);
-    else {
+    else if (alg_name == "-portfolio") {
+        portfolio_options options;
+        options.time_limit = 300;
+        options.progress = progress;
+        return portfolio_algorithm(points, options).guards;
+    } else {
         instruction();
         exit(-1);
     }
 }
 
+/// Reads names of instances already present in the output file.
+std::set<std::string> finished_instances(const std::string &output_file) {
+    std::set<std::string> finished;
+    std::ifstream in(output_file);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string file;
+        if (fields >> file)
+            finished.insert(file);
+    }
+    return finished;
+}
+
+/// Writes the profile of an instance as <dir>/<instance>.profile.json and a
+/// Chrome trace as <dir>/<instance>.trace.json.
+void write_profile(const std::string &profile_dir, const std::string &f) {
+    std::string name = f.substr(f.find_last_of('/') + 1);
+    std::ofstream summary(profile_dir + "/" + name + ".profile.json");
+    write_profile_json(summary);
+    std::ofstream trace(profile_dir + "/" + name + ".trace.json");
+    write_chrome_trace(trace);
+}
+
+/// Writes a line "iteration time lower_bound upper_bound incumbent_size
+/// guards witnesses" to <dir>/<instance>.convergence after each iteration.
+progress_callback convergence_writer(const std::string &convergence_dir,
+                                     const std::string &f) {
+    std::string name = f.substr(f.find_last_of('/') + 1);
+    auto out = std::make_shared<std::ofstream>(convergence_dir + "/" + name +
+                                               ".convergence");
+    return [out](const iteration_progress &state) {
+        *out << state.iteration << " " << state.elapsed << " "
+             << state.lower_bound << " " << state.upper_bound << " "
+             << state.incumbent.size() << " " << state.guards << " "
+             << state.witnesses << std::endl;
+        return true;
+    };
+}
+
+void solve_instance(const std::string &f, const std::string &algorithm,
+                    const experiment_settings &settings,
+                    const report_function &report) {
+    if (!settings.profile_dir.empty()) {
+        set_profiling(true);
+        set_heap_profiling(settings.profile_heap);
+        reset_profile();
+    }
+    std::vector<Kernel::Point_2> points;
+    test_case(f, points);
+    report("vertices " + std::to_string(points.size()));
+
+    progress_callback progress;
+    if (!settings.convergence_dir.empty())
+        progress = convergence_writer(settings.convergence_dir, f);
+    bool budget_exceeded = false;
+    if (settings.memory_budget)
+        progress = memory_budget(settings.memory_budget, progress,
+                                 &budget_exceeded);
+
+    // the number of iterations tells apart placements that only differ in
+    // the cost of building the initial regions
+    unsigned long iterations = 0;
+    progress = [progress, &iterations](const iteration_progress &state) {
+        iterations = state.iteration;
+        return !progress || progress(state);
+    };
+
+    compaction_stats stats;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto guards = find_guards(points, algorithm, settings, stats, progress);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    auto time_span =
+        std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+
+    if (stats.passes) {
+        std::cout << f << ": " << stats.passes << " compaction passes freed "
+                  << stats.freed_bytes / (1024 * 1024) << " MB\n";
+    }
+    report("guards " + std::to_string(guards.size()) + " " +
+           std::to_string(time_span.count()));
+    report("iterations " + std::to_string(iterations));
+    if (budget_exceeded)
+        report("budget");
+    if (settings.verify) {
+        auto witnesses = verify_guards(points, guards);
+        report("uncovered " + std::to_string(witnesses.size()));
+    }
+    if (!settings.profile_dir.empty())
+        write_profile(settings.profile_dir, f);
+}
+
 void run_experiment(const std::string &dir_path, const std::string &algorithm,
-                    const std::string &output_file) {
+                    const std::string &output_file,
+                    const experiment_settings &settings,
+                    const scheduler_options &options, bool resume) {
 
-    std::ofstream out(output_file), ef("exceptions.out");
+    std::set<std::string> finished;
+    if (resume)
+        finished = finished_instances(output_file);
+
+    std::ofstream out(output_file, resume ? std::ios::app : std::ios::trunc),
+        ef("exceptions.out", std::ios::app);
     std::map<unsigned, std::vector<double>> results;
-    auto files = read_directory(dir_path);
-    std::cout << "Instances from directory " << dir_path << ": " << files.size()
-              << "\n";
-
-    int i = 0;
-    for (const auto &f : files) {
-        try {
-            std::vector<Kernel::Point_2> points;
-            test_case(f, points);
-
-            std::cout << ++i << "/" << files.size() << " " << f << ": "
-                      << points.size() << " vertices.\n";
-
-            auto t1 = std::chrono::high_resolution_clock::now();
-            auto guards = find_guards(points, algorithm);
-            auto t2 = std::chrono::high_resolution_clock::now();
-            auto time_span =
-                std::chrono::duration_cast<std::chrono::duration<double>>(t2 -
-                                                                          t1);
-
-            out << f << " " << points.size() << " " << guards.size() << " "
-                << time_span.count() << "\n";
-
-            auto n = points.size();
-            if (results.find(n) == results.end()) {
-                results[n] = std::vector<double>();
-            }
-            results[n].push_back(time_span.count());
-        } catch (const std::exception &e) {
-            std::cerr << "Exception e caught!\n";
-            std::cerr << e.what() << "\n";
-            ef << f << " " << e.what() << "\n";
-        } catch (...) {
-            std::cerr << "Exception caught \n";
-            ef << f << "\n";
-        }
+    std::vector<std::string> files;
+    for (const auto &f : read_directory(dir_path)) {
+        if (finished.find(f) == finished.end())
+            files.push_back(f);
     }
+    std::cout << "Instances from directory " << dir_path << ": "
+              << files.size() + finished.size() << ", to solve "
+              << files.size() << "\n";
+
+    std::size_t i = 0;
+    auto record = [&](const instance_outcome &outcome) {
+        auto result = summarize_outcome(outcome);
+        unsigned n = result.vertices;
+        const std::string &status = result.status;
+        double peak_mb = outcome.peak_memory / (1024.0 * 1024.0);
+
+        std::cout << ++i << "/" << files.size() << " " << outcome.file << ": "
+                  << n << " vertices, " << status << ", " << peak_mb
+                  << " MB\n";
+
+        // The status, the peak memory in MB and the number of iterations are
+        // appended after the original columns, so scripts reading the first
+        // columns still work.
+        out << outcome.file << " " << n << " " << result.guards << " "
+            << result.time << " " << status << " " << peak_mb << " "
+            << result.iterations << std::endl;
+
+        if (status == "ok") {
+            results[n].push_back(result.time);
+        } else {
+            std::cerr << outcome.file << ": " << status << " " << result.error
+                      << "\n";
+            ef << outcome.file << " " << status << " " << result.error
+               << "\n";
+        }
+    };
+
+    run_instances(
+        files, options,
+        [&](const std::string &f, const report_function &report) {
+            solve_instance(f, algorithm, settings, report);
+        },
+        record);
 
     out.close();
     ef.close();
@@ -149,8 +296,65 @@ int main(int argc, char *argv[]) {
     }
 
     std::string dir_name = argv[1], algorithm = argv[2], output_file = argv[3];
+    if (algorithm != "-fisk" && algorithm != "-ghosh" &&
+        algorithm != "-couto" && algorithm != "-baumgartner" &&
+        algorithm != "-portfolio") {
+        instruction("unknown algorithm " + algorithm);
+        exit(-1);
+    }
+    experiment_settings settings;
+    scheduler_options options;
+    bool resume = false, threads_given = false;
+    for (int i = 4; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-compact" && i + 1 < argc)
+            settings.compaction_interval = std::stoul(argv[++i]);
+        else if (arg == "-cache" && i + 1 < argc)
+            set_visibility_cache_directory(argv[++i]);
+        else if (arg == "-j" && i + 1 < argc)
+            options.workers = std::stoul(argv[++i]);
+        else if (arg == "-timeout" && i + 1 < argc)
+            options.time_limit = std::stod(argv[++i]);
+        else if (arg == "-memory" && i + 1 < argc)
+            options.memory_limit = std::stoul(argv[++i]) * 1024 * 1024;
+        else if (arg == "-resume")
+            resume = true;
+        else if (arg == "-profile" && i + 1 < argc)
+            settings.profile_dir = argv[++i];
+        else if (arg == "-profile-heap")
+            settings.profile_heap = true;
+        else if (arg == "-convergence" && i + 1 < argc)
+            settings.convergence_dir = argv[++i];
+        else if (arg == "-no-verify")
+            settings.verify = false;
+        else if (arg == "-budget" && i + 1 < argc)
+            settings.memory_budget = std::stoul(argv[++i]) * 1024 * 1024;
+        else if (arg == "-threads" && i + 1 < argc) {
+            set_thread_count(std::stoul(argv[++i]));
+            threads_given = true;
+        }
+        else if (arg == "-placement" && i + 1 < argc) {
+            settings.placement = argv[++i];
+            try {
+                placement_by_name(settings.placement);
+            } catch (const std::invalid_argument &e) {
+                instruction(e.what());
+                exit(-1);
+            }
+        }
+        else {
+            instruction("unknown option " + arg);
+            exit(-1);
+        }
+    }
+
+    // Every worker process has its own pool, together they share the cores.
+    // The count is set before the workers are forked, so they inherit it.
+    if (!threads_given && options.workers > 1)
+        set_thread_count(std::max(1u, thread_count() / options.workers));
 
-    run_experiment(dir_name, algorithm, output_file);
+    run_experiment(dir_name, algorithm, output_file, settings, options,
+                   resume);
 
     return 0;
 }
@@ -0,0 +1,36 @@
+#include "outcome.h"
+
+#include <sstream>
+
+instance_result summarize_outcome(const instance_outcome &outcome) {
+    instance_result result;
+    unsigned uncovered = 0;
+    bool budget = false;
+    result.time = outcome.wall_time;
+    result.status = status_name(outcome.status);
+    for (const auto &message : outcome.messages) {
+        std::istringstream fields(message);
+        std::string key;
+        fields >> key;
+        if (key == "vertices")
+            fields >> result.vertices;
+        else if (key == "guards")
+            fields >> result.guards >> result.time;
+        else if (key == "iterations")
+            fields >> result.iterations;
+        else if (key == "uncovered")
+            fields >> uncovered;
+        else if (key == "budget")
+            budget = true;
+        else if (key == "error")
+            std::getline(fields >> std::ws, result.error);
+    }
+    if (outcome.status == instance_status::ok && budget) {
+        result.status = "budget";
+        result.error = "stopped by the memory budget";
+    } else if (outcome.status == instance_status::ok && uncovered) {
+        result.status = "uncovered";
+        result.error = std::to_string(uncovered) + " uncovered witnesses";
+    }
+    return result;
+}
@@ -0,0 +1,37 @@
+/*! \file outcome.h
+ * \brief Turns the lines reported by an experiment worker into the values
+ * written to the result file.
+ *
+ * A worker reports "vertices n", "guards count seconds", "iterations count",
+ * "uncovered count", "budget" if the memory budget stopped the algorithm and
+ * "error message" if it failed.
+ */
+#ifndef AGP_EXPERIMENTS_OUTCOME_H
+#define AGP_EXPERIMENTS_OUTCOME_H
+
+#include "scheduler.h"
+
+#include <string>
+
+/*! \struct instance_result
+ * Values of one instance in the result file.
+ */
+struct instance_result {
+    unsigned vertices = 0;   /*!< number of vertices of the gallery */
+    unsigned guards = 0;     /*!< number of guards found */
+    double time = 0;         /*!< solve time, the wall time if not reported */
+    unsigned iterations = 0; /*!< iterations of the algorithm */
+    std::string status;      /*!< status of the worker, or "budget" and
+                              * "uncovered" for a worker that finished with a
+                              * stopped run or guards not covering the
+                              * gallery */
+    std::string error;       /*!< description of a status other than "ok" */
+};
+
+/*! \fn instance_result summarize_outcome(const instance_outcome &outcome)
+ * @param outcome - result of a worker
+ * @return values of the instance in the result file
+ */
+instance_result summarize_outcome(const instance_outcome &outcome);
+
+#endif // AGP_EXPERIMENTS_OUTCOME_H
@@ -0,0 +1,205 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using clock_type = std::chrono::steady_clock;
+
+const int exit_error = 2;
+const int exit_out_of_memory = 3;
+
+struct worker {
+    pid_t pid;
+    int fd;
+    std::string file;
+    std::string buffer;
+    std::vector<std::string> messages;
+    clock_type::time_point start;
+    bool killed;
+    instance_status kill_status;
+    std::size_t peak_memory;
+};
+
+const char *status_name(instance_status status) {
+    switch (status) {
+    case instance_status::ok:
+        return "ok";
+    case instance_status::timeout:
+        return "timeout";
+    case instance_status::out_of_memory:
+        return "oom";
+    case instance_status::error:
+        return "error";
+    case instance_status::crash:
+        return "crash";
+    }
+    return "unknown";
+}
+
+void write_all(int fd, const std::string &data) {
+    std::size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+        written += n;
+    }
+}
+
+std::size_t worker_memory(pid_t pid) {
+    std::string path = "/proc/" + std::to_string(pid) + "/statm";
+    FILE *f = std::fopen(path.c_str(), "r");
+    if (!f)
+        return 0;
+    unsigned long size = 0, resident = 0;
+    if (std::fscanf(f, "%lu %lu", &size, &resident) != 2)
+        resident = 0;
+    std::fclose(f);
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/// Reads everything available in the pipe and splits it into lines.
+void drain(worker &w) {
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(w.fd, chunk, sizeof(chunk))) > 0) {
+        w.buffer.append(chunk, n);
+    }
+    std::size_t pos;
+    while ((pos = w.buffer.find('\n')) != std::string::npos) {
+        w.messages.push_back(w.buffer.substr(0, pos));
+        w.buffer.erase(0, pos + 1);
+    }
+}
+
+worker spawn(
+    const std::string &file,
+    const std::function<void(const std::string &, const report_function &)>
+        &solve) {
+    int fds[2];
+    if (pipe(fds) < 0)
+        throw std::runtime_error("cannot create a pipe");
+
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0)
+        throw std::runtime_error("cannot fork a worker");
+
+    if (pid == 0) {
+        close(fds[0]);
+        int code = 0;
+        report_function report = [&](const std::string &line) {
+            write_all(fds[1], line + "\n");
+        };
+        try {
+            solve(file, report);
+        } catch (const std::bad_alloc &) {
+            code = exit_out_of_memory;
+        } catch (const std::exception &e) {
+            report(std::string("error ") + e.what());
+            code = exit_error;
+        } catch (...) {
+            code = exit_error;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        close(fds[1]);
+        _exit(code);
+    }
+
+    close(fds[1]);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    return {pid,   fds[0], file, "", {}, clock_type::now(), false,
+            instance_status::ok, 0};
+}
+
+instance_status exit_status(const worker &w, int status) {
+    if (w.killed)
+        return w.kill_status;
+    if (WIFEXITED(status)) {
+        switch (WEXITSTATUS(status)) {
+        case 0:
+            return instance_status::ok;
+        case exit_out_of_memory:
+            return instance_status::out_of_memory;
+        default:
+            return instance_status::error;
+        }
+    }
+    return instance_status::crash;
+}
+
+void run_instances(
+    const std::vector<std::string> &files, const scheduler_options &options,
+    const std::function<void(const std::string &, const report_function &)>
+        &solve,
+    const std::function<void(const instance_outcome &)> &finished) {
+    unsigned workers = options.workers ? options.workers : 1;
+    std::vector<worker> running;
+    std::size_t next = 0;
+
+    while (next < files.size() || !running.empty()) {
+        while (running.size() < workers && next < files.size()) {
+            running.push_back(spawn(files[next++], solve));
+        }
+
+        std::vector<pollfd> fds;
+        for (const auto &w : running) {
+            fds.push_back({w.fd, POLLIN, 0});
+        }
+        poll(fds.data(), fds.size(), 100);
+
+        for (auto it = running.begin(); it != running.end();) {
+            drain(*it);
+            double elapsed =
+                std::chrono::duration<double>(clock_type::now() - it->start)
+                    .count();
+            if (!it->killed && options.time_limit > 0 &&
+                elapsed > options.time_limit) {
+                it->killed = true;
+                it->kill_status = instance_status::timeout;
+                kill(it->pid, SIGKILL);
+            }
+            if (!it->killed) {
+                std::size_t memory = worker_memory(it->pid);
+                it->peak_memory = std::max(it->peak_memory, memory);
+                if (options.memory_limit > 0 &&
+                    memory > options.memory_limit) {
+                    it->killed = true;
+                    it->kill_status = instance_status::out_of_memory;
+                    kill(it->pid, SIGKILL);
+                }
+            }
+
+            int status;
+            struct rusage usage;
+            if (wait4(it->pid, &status, WNOHANG, &usage) != it->pid) {
+                ++it;
+                continue;
+            }
+            drain(*it);
+            close(it->fd);
+            // Linux reports the peak resident memory in kilobytes.
+            std::size_t peak = std::max<std::size_t>(
+                it->peak_memory, usage.ru_maxrss * std::size_t(1024));
+            finished({it->file, exit_status(*it, status), it->messages,
+                      elapsed, peak});
+            it = running.erase(it);
+        }
+    }
+}
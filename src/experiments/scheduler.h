@@ -0,0 +1,63 @@
+/*! \file scheduler.h
+ * \brief Runs experiment instances in forked worker processes.
+ *
+ * Every instance is solved in its own child process, so a crash, a hang or
+ * running out of memory affects only that instance. Workers report progress
+ * to the parent as lines of text sent through a pipe. The parent kills workers
+ * that exceed the wall-time or resident memory limit.
+ */
+#ifndef AGP_EXPERIMENTS_SCHEDULER_H
+#define AGP_EXPERIMENTS_SCHEDULER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*! \struct scheduler_options
+ * Limits of the scheduler, 0 means no limit.
+ */
+struct scheduler_options {
+    unsigned workers = 1;         /*!< number of parallel workers */
+    double time_limit = 0;        /*!< wall time per instance in seconds */
+    std::size_t memory_limit = 0; /*!< resident memory per instance in bytes */
+};
+
+enum class instance_status { ok, timeout, out_of_memory, error, crash };
+
+/*! \fn const char *status_name(instance_status status)
+ * @return name of the status as written to result files
+ */
+const char *status_name(instance_status status);
+
+/*! \struct instance_outcome
+ * Result of solving one instance.
+ */
+struct instance_outcome {
+    std::string file;                  /*!< path to the instance */
+    instance_status status;            /*!< how the worker finished */
+    std::vector<std::string> messages; /*!< lines reported by the worker */
+    double wall_time;                  /*!< time the worker ran in seconds */
+    std::size_t peak_memory;           /*!< peak resident memory in bytes */
+};
+
+using report_function = std::function<void(const std::string &)>;
+
+/*! \fn void run_instances(const std::vector<std::string> &files, const
+ * scheduler_options &options, const std::function<void(const std::string &,
+ * const report_function &)> &solve, const std::function<void(const
+ * instance_outcome &)> &finished) \brief Solves instances on parallel workers.
+ * @param files - paths to instances
+ * @param options - number of workers and limits
+ * @param solve - function run in a worker process for one instance, it may
+ * send lines to the parent with the given report function, std::bad_alloc
+ * thrown by it is treated as running out of memory
+ * @param finished - called in the parent process when an instance finishes
+ */
+void run_instances(
+    const std::vector<std::string> &files, const scheduler_options &options,
+    const std::function<void(const std::string &, const report_function &)>
+        &solve,
+    const std::function<void(const instance_outcome &)> &finished);
+
+#endif // AGP_EXPERIMENTS_SCHEDULER_H
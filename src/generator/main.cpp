@@ -0,0 +1,72 @@
+#include <agp/generators/polygon_generators.h>
+#include <agp/io/gallery_io.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+void instruction() {
+    std::cerr << "./generate family size [-seed seed] [out_filename]\n"
+                 "Families: -random n, -orthogonal n, -vonkoch level, "
+                 "-spiral n, -comb teeth\n"
+                 "Galleries are written to the standard output, or to a file "
+                 "(binary if its extension is .agpb).\n";
+}
+
+std::vector<Kernel::Point_2> generate(const std::string &family,
+                                      std::size_t size, std::uint64_t seed) {
+    if (family == "-random")
+        return random_polygon(size, seed);
+    else if (family == "-orthogonal")
+        return orthogonal_polygon(size, seed);
+    else if (family == "-vonkoch")
+        return von_koch_polygon(size);
+    else if (family == "-spiral")
+        return spiral_polygon(size);
+    else if (family == "-comb")
+        return comb_polygon(size);
+    else {
+        instruction();
+        exit(-1);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        instruction();
+        exit(-1);
+    }
+
+    std::string family = argv[1], out_filename;
+    std::uint64_t seed = 0;
+    std::size_t size = std::stoull(argv[2]);
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-seed" && i + 1 < argc)
+            seed = std::stoull(argv[++i]);
+        else if (arg[0] != '-' && out_filename.empty())
+            out_filename = arg;
+        else {
+            instruction();
+            exit(-1);
+        }
+    }
+
+    try {
+        auto points = generate(family, size, seed);
+        if (out_filename.empty()) {
+            write_pol(std::cout, points);
+        } else if (out_filename.size() > 5 &&
+                   out_filename.substr(out_filename.size() - 5) == ".agpb") {
+            write_gallery_binary(out_filename, points, coordinate_type::int64);
+        } else {
+            std::ofstream out(out_filename);
+            write_pol(out, points);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        exit(-1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <agp/parallel/arena.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+
+TEST_CASE("Arena memory is reused after a rewind") {
+    arena a(256);
+    auto start = a.mark();
+    void *first = a.allocate(100);
+    void *second = a.allocate(100);
+    REQUIRE(first != second);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) %
+                alignof(std::max_align_t) ==
+            0);
+    a.allocate(1000);
+    std::size_t capacity = a.capacity();
+    a.rewind(start);
+    REQUIRE(a.allocate(100) == first);
+    a.allocate(100);
+    a.allocate(1000);
+    REQUIRE(a.capacity() == capacity);
+}
+
+TEST_CASE("Allocator uses the heap outside of a scope") {
+    REQUIRE(current_arena() == nullptr);
+    arena_list<int> list = {1, 2, 3};
+    REQUIRE(list.size() == 3);
+}
+
+TEST_CASE("Scopes take memory from the thread's arena") {
+    arena_list<int> outside = {1};
+    {
+        arena_scope scope;
+        REQUIRE(current_arena() != nullptr);
+        arena_list<int> inner;
+        for (int i = 0; i < 10000; ++i)
+            inner.push_back(i);
+        outside.push_back(2);
+        outside.pop_back();
+        {
+            arena_scope nested;
+            arena_list<int> more(100, 7);
+            REQUIRE(more.back() == 7);
+        }
+        REQUIRE(inner.back() == 9999);
+    }
+    REQUIRE(current_arena() == nullptr);
+    REQUIRE(outside.front() == 1);
+}
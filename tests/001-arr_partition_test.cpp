@@ -4,6 +4,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
 std::vector<Kernel::Point_2> get_instance_from_file(std::ifstream &in) {
     std::vector<Kernel::Point_2> points;
     int n;
@@ -86,3 +89,48 @@ TEST_CASE("Convex components (100 vertices) ") {
         REQUIRE(pol.is_convex());
     }
 }
+
+TEST_CASE("Simplest rational in an interval") {
+    REQUIRE(simplest_rational(Kernel::FT(1) / 2, Kernel::FT(1)) ==
+            Kernel::FT(2) / 3);
+    REQUIRE(simplest_rational(Kernel::FT(-3), Kernel::FT(5)) == 0);
+    REQUIRE(simplest_rational(Kernel::FT(7) / 3, Kernel::FT(9) / 2) == 3);
+    REQUIRE(simplest_rational(Kernel::FT(-9) / 2, Kernel::FT(-7) / 3) == -4);
+    REQUIRE(simplest_rational(Kernel::FT(999999) / 3000000,
+                              Kernel::FT(1000001) / 3000000) ==
+            Kernel::FT(1) / 3);
+}
+
+TEST_CASE("Small interior point of a convex polygon") {
+    Kernel::FT third = Kernel::FT(1) / 3;
+    std::vector<Kernel::Point_2> triangle = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(1, 0), Kernel::Point_2(0, 1)};
+    REQUIRE(small_interior_point(triangle) ==
+            Kernel::Point_2(Kernel::FT(1) / 2, Kernel::FT(1) / 3));
+
+    std::vector<Kernel::Point_2> shifted = {
+        Kernel::Point_2(third / 7, third / 11),
+        Kernel::Point_2(3 + third / 13, third / 17),
+        Kernel::Point_2(2 + third / 19, 3 + third / 23)};
+    auto p = small_interior_point(shifted);
+    REQUIRE(CGAL::bounded_side_2(shifted.begin(), shifted.end(), p) ==
+            CGAL::ON_BOUNDED_SIDE);
+    REQUIRE(CGAL::exact(p.x()).denominator() <= 2);
+}
+
+TEST_CASE("Extension chords of an L-shaped polygon") {
+    std::vector<Kernel::Point_2> l_shape = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(2, 0), Kernel::Point_2(2, 1),
+        Kernel::Point_2(1, 1), Kernel::Point_2(1, 2), Kernel::Point_2(0, 2)};
+    auto chords = extension_chords(l_shape);
+    REQUIRE(chords.size() == 2);
+    for (const auto &c : chords) {
+        REQUIRE(c.source() == Kernel::Point_2(1, 1));
+        REQUIRE((c.target() == Kernel::Point_2(0, 1) ||
+                 c.target() == Kernel::Point_2(1, 0)));
+    }
+
+    // the edges at the convex vertices of the reversed polygon leave it
+    std::reverse(l_shape.begin(), l_shape.end());
+    REQUIRE_THROWS_AS(extension_chords(l_shape), std::invalid_argument);
+}
@@ -107,3 +107,45 @@ TEST_CASE("Overlay not overlaying arrangement") {
         REQUIRE(vit->degree() == 2);
     }
 }
+
+TEST_CASE("Share regions without copying them") {
+    std::vector<Kernel::Point_2> points1 = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(4, 4),
+        Kernel::Point_2(0, 4)};
+    std::vector<Kernel::Point_2> points2 = {
+        Kernel::Point_2(6, 0), Kernel::Point_2(8, 0), Kernel::Point_2(8, 2),
+        Kernel::Point_2(6, 2)};
+    std::vector<Arrangement_2> regions(2);
+    insert_polygon(regions[0], points1.begin(), points1.end());
+    insert_polygon(regions[1], points2.begin(), points2.end());
+    const Arrangement_2 *first = &regions[0];
+    auto handles = share_regions(std::move(regions));
+    REQUIRE(handles.size() == 2);
+    REQUIRE(handles[0].get() == first);
+    REQUIRE(handles[1]->number_of_vertices() == 4);
+    REQUIRE(total_vertices(handles) == 8);
+}
+
+TEST_CASE("Overlay shared regions on a primary arrangement") {
+    std::vector<Kernel::Point_2> points1 = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(4, 4),
+        Kernel::Point_2(0, 4)};
+    std::vector<Kernel::Point_2> points2 = {
+        Kernel::Point_2(6, 0), Kernel::Point_2(8, 0), Kernel::Point_2(8, 2),
+        Kernel::Point_2(6, 2)};
+    std::vector<Kernel::Point_2> points3 = {
+        Kernel::Point_2(10, 0), Kernel::Point_2(12, 0),
+        Kernel::Point_2(12, 2)};
+    std::vector<region_handle> handles = {
+        std::make_shared<const Arrangement_2>(
+            create_arrangement<Arrangement_2>(points2)),
+        std::make_shared<const Arrangement_2>(
+            create_arrangement<Arrangement_2>(points3))};
+    auto primary = create_arrangement<Arrangement_2>(points1);
+    auto overlay_arr = overlay_arrangements(primary, handles);
+    REQUIRE(overlay_arr.number_of_faces() == 4);
+    REQUIRE(overlay_arr.number_of_edges() == 11);
+    auto only_primary =
+        overlay_arrangements(primary, std::vector<region_handle>());
+    REQUIRE(only_primary.number_of_edges() == 4);
+}
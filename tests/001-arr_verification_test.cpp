@@ -0,0 +1,34 @@
+#include <agp/arrangement/verification.h>
+#include <agp/arrangement/visibility.h>
+#include <agp/generators/polygon_generators.h>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Guards covering a gallery leave no witnesses") {
+    std::vector<Kernel::Point_2> square = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(4, 4),
+        Kernel::Point_2(0, 4)};
+    REQUIRE(verify_guards(square, {Kernel::Point_2(0, 0)}).empty());
+    REQUIRE(verify_guards(square, {Kernel::Point_2(1, 3)}).empty());
+    REQUIRE(verify_guards(square, {Kernel::Point_2(2, 0)}).empty());
+
+    auto comb = comb_polygon(5);
+    REQUIRE(verify_guards(comb, comb, 3).empty());
+}
+
+TEST_CASE("Uncovered parts of a gallery are reported") {
+    auto comb = comb_polygon(4);
+    std::vector<Kernel::Point_2> guards = {Kernel::Point_2(1, 10),
+                                           Kernel::Point_2(5, 10)};
+    auto witnesses = verify_guards(comb, guards, 2);
+    REQUIRE(!witnesses.empty());
+
+    auto polygon = create_arrangement<Arrangement_2>(comb);
+    for (const auto &w : witnesses) {
+        for (const auto &g : guards) {
+            REQUIRE(!point_visible(general_point_visibility_region(polygon, g),
+                                   w));
+        }
+    }
+    REQUIRE(verify_guards(comb, {}).size() >= 1);
+}
@@ -0,0 +1,162 @@
+#include <agp/algo/coverage_reduction.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+/// Builds a coverage matrix from rows written as strings of guards, "0110"
+/// means that the witness is seen by guards 1 and 2.
+coverage_matrix matrix_of(const std::vector<std::string> &rows) {
+    coverage_matrix matrix;
+    for (const auto &r : rows) {
+        boost::dynamic_bitset<> row(r.size());
+        for (std::size_t j = 0; j < r.size(); ++j)
+            row[j] = r[j] == '1';
+        matrix.push_back(row);
+    }
+    return matrix;
+}
+
+/// Random matrix in which every witness is seen by some guard.
+coverage_matrix random_matrix(std::mt19937 &random, std::size_t witnesses,
+                              std::size_t guards) {
+    coverage_matrix matrix;
+    for (std::size_t i = 0; i < witnesses; ++i) {
+        boost::dynamic_bitset<> row(guards);
+        for (std::size_t j = 0; j < guards; ++j)
+            row[j] = random() % 3 == 0;
+        if (row.none())
+            row[random() % guards] = true;
+        matrix.push_back(row);
+    }
+    return matrix;
+}
+
+/// Size of the smallest cover, found by trying all subsets of the guards.
+std::size_t minimum_cover(const coverage_matrix &matrix, std::size_t guards) {
+    std::size_t best = guards;
+    for (unsigned long subset = 0; subset < (1ul << guards); ++subset) {
+        boost::dynamic_bitset<> chosen(guards, subset);
+        if (std::all_of(matrix.begin(), matrix.end(),
+                        [&chosen](const boost::dynamic_bitset<> &row) {
+                            return row.intersects(chosen);
+                        }))
+            best = std::min(best, chosen.count());
+    }
+    return best;
+}
+
+TEST_CASE("Dominated witnesses and guards are dropped") {
+    // witness 1 is covered whenever witness 0 is, guard 2 sees less than
+    // guard 1
+    auto matrix = matrix_of({"1100", "1110", "0111", "1001"});
+    auto reduction = reduce_coverage(matrix, 4);
+    REQUIRE(std::find(reduction.witnesses.begin(), reduction.witnesses.end(),
+                      1) == reduction.witnesses.end());
+    REQUIRE(std::find(reduction.guards.begin(), reduction.guards.end(), 2) ==
+            reduction.guards.end());
+    REQUIRE(reduction.forced.empty());
+    REQUIRE(reduction.matrix.size() == reduction.witnesses.size());
+    for (const auto &row : reduction.matrix)
+        REQUIRE(row.size() == reduction.guards.size());
+}
+
+TEST_CASE("Guards seen alone are forced") {
+    auto matrix = matrix_of({"100", "110", "011", "001"});
+    auto reduction = reduce_coverage(matrix, 3);
+    // guards 0 and 2 are forced by witnesses 0 and 3 and cover everything
+    REQUIRE(reduction.witnesses.empty());
+    auto guards = expand_guards(reduction, {});
+    std::sort(guards.begin(), guards.end());
+    REQUIRE(guards == std::vector<int>{0, 2});
+
+    auto x = expand_guard_values(reduction, std::vector<double>(
+                                                reduction.guards.size(), 0));
+    REQUIRE(x == std::vector<double>{1, 0, 1});
+    auto y = expand_witness_values(reduction, {});
+    REQUIRE(y == std::vector<double>{1, 0, 0, 1});
+}
+
+TEST_CASE("Reduced solutions map back to covers") {
+    auto matrix = matrix_of(
+        {"110000", "011000", "001100", "000110", "000011", "100001", "111111"});
+    auto reduction = reduce_coverage(matrix, 6);
+    REQUIRE(reduction.witnesses.size() == 6);
+    REQUIRE(reduction.guards.size() == 6);
+    // a cover of the reduced cycle is a cover of the original matrix
+    std::vector<int> chosen;
+    for (std::size_t k = 0; k < reduction.guards.size(); k += 2)
+        chosen.push_back(static_cast<int>(k));
+    auto guards = expand_guards(reduction, chosen);
+    for (const auto &row : matrix)
+        REQUIRE(std::any_of(guards.begin(), guards.end(),
+                            [&row](int g) { return row[g]; }));
+}
+
+TEST_CASE("Witnesses seen by no guard are kept") {
+    auto matrix = matrix_of({"000", "110", "011"});
+    auto reduction = reduce_coverage(matrix, 3);
+    REQUIRE(reduction.witnesses.front() == 0);
+    REQUIRE(reduction.matrix.front().none());
+}
+
+TEST_CASE("Reduction keeps the optimum") {
+    std::mt19937 random(7);
+    for (int test = 0; test < 500; ++test) {
+        std::size_t guards = 1 + random() % 8;
+        auto matrix = random_matrix(random, random() % 10, guards);
+        auto reduction = reduce_coverage(matrix, guards);
+        REQUIRE(minimum_cover(reduction.matrix, reduction.guards.size()) +
+                    reduction.forced.size() ==
+                minimum_cover(matrix, guards));
+    }
+}
+
+TEST_CASE("Expanded dual solutions stay feasible") {
+    std::mt19937 random(11);
+    for (int test = 0; test < 500; ++test) {
+        std::size_t guards = 1 + random() % 8;
+        auto matrix = random_matrix(random, random() % 10, guards);
+        auto reduction = reduce_coverage(matrix, guards);
+        // greedy feasible dual of the reduced matrix, every guard sees
+        // witnesses of total value at most 1
+        std::vector<double> values(reduction.witnesses.size(), 0);
+        std::vector<double> load(reduction.guards.size(), 0);
+        for (std::size_t k = 0; k < values.size(); ++k) {
+            double value = random() % 2 ? 1.0 : 0.5;
+            for (std::size_t j = 0; j < load.size(); ++j)
+                if (reduction.matrix[k][j])
+                    value = std::min(value, 1 - load[j]);
+            values[k] = value;
+            for (std::size_t j = 0; j < load.size(); ++j)
+                if (reduction.matrix[k][j])
+                    load[j] += value;
+        }
+        auto y = expand_witness_values(reduction, values);
+        for (std::size_t j = 0; j < guards; ++j) {
+            double seen = 0;
+            for (std::size_t i = 0; i < matrix.size(); ++i)
+                if (matrix[i][j])
+                    seen += y[i];
+            REQUIRE(seen <= 1);
+        }
+        double reduced = 0, expanded = 0;
+        for (auto v : values)
+            reduced += v;
+        for (auto v : y)
+            expanded += v;
+        REQUIRE(expanded == reduced + reduction.forced.size());
+    }
+}
+
+TEST_CASE("Over the work limit only forced guards are fixed") {
+    auto matrix = matrix_of({"100", "110", "011", "011"});
+    auto reduction = reduce_coverage(matrix, 3, 0);
+    REQUIRE(reduction.forced == std::vector<std::size_t>{0});
+    // the duplicate witness and the dominated guard 1 stay
+    REQUIRE(reduction.witnesses == std::vector<std::size_t>{2, 3});
+    REQUIRE(reduction.guards == std::vector<std::size_t>{1, 2});
+    REQUIRE(minimum_cover(reduction.matrix, 2) + 1 == minimum_cover(matrix, 3));
+}
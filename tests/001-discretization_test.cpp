@@ -0,0 +1,77 @@
+#include "test_polygons.h"
+
+#include <agp/arrangement/verification.h>
+#include <agp/arrangement/visibility.h>
+#include <agp/discretization_methods.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+/// Checks whether every witness is seen by one of the guards.
+bool witnesses_seen(const std::vector<Kernel::Point_2> &witnesses,
+                    const std::vector<Arrangement_2> &regions,
+                    const std::vector<int> &guards) {
+    return std::all_of(
+        witnesses.begin(), witnesses.end(), [&](const Kernel::Point_2 &w) {
+            return std::any_of(guards.begin(), guards.end(), [&](int g) {
+                return point_visible(regions[g], w);
+            });
+        });
+}
+
+TEST_CASE("Shadow AVPs lie inside the polygon") {
+    auto points = orthogonal_comb();
+    auto witnesses = shadow_avp(points);
+    REQUIRE_FALSE(witnesses.empty());
+    for (const auto &w : witnesses)
+        REQUIRE(CGAL::bounded_side_2(points.begin(), points.end(), w) ==
+                CGAL::ON_BOUNDED_SIDE);
+}
+
+TEST_CASE("Shadow AVPs are seen only by covering guards") {
+    auto points = orthogonal_comb();
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto regions = all_visibility_regions(polygon, points);
+    auto witnesses = shadow_avp(points);
+    // every vertex sees some of the polygon only
+    for (int i = 0; i < int(points.size()); ++i)
+        REQUIRE_FALSE(witnesses_seen(witnesses, regions, {i}));
+    // pairs and triples of vertices see the shadow AVPs exactly when they
+    // see the whole polygon
+    int n = points.size();
+    for (int a = 0; a < n; ++a) {
+        for (int b = a + 1; b < n; ++b) {
+            for (int c = b + 1; c <= n; ++c) {
+                std::vector<int> guards = {a, b};
+                if (c < n)
+                    guards.push_back(c);
+                std::vector<Kernel::Point_2> guard_points;
+                for (int g : guards)
+                    guard_points.push_back(points[g]);
+                REQUIRE(witnesses_seen(witnesses, regions, guards) ==
+                        verify_guards(points, guard_points).empty());
+            }
+        }
+    }
+}
+
+TEST_CASE("Faces of the reflex extensions") {
+    auto points = orthogonal_comb();
+    auto discretization = reflex_extension(points);
+    // five cells below the notches and the three teeth
+    REQUIRE(discretization.size() == 8);
+    for (const auto &p : discretization)
+        REQUIRE(CGAL::bounded_side_2(points.begin(), points.end(), p) ==
+                CGAL::ON_BOUNDED_SIDE);
+
+    // the number of points doesn't depend on the scale or the orientation
+    std::vector<Kernel::Point_2> scaled;
+    for (auto it = points.rbegin(); it != points.rend(); ++it)
+        scaled.emplace_back(it->x() * 1000, it->y() * 1000);
+    REQUIRE(reflex_extension(scaled).size() == 8);
+
+    std::vector<Kernel::Point_2> triangle = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(0, 4)};
+    REQUIRE(reflex_extension(triangle).size() == 1);
+}
@@ -0,0 +1,42 @@
+#include "outcome.h"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Worker reports become result file values") {
+    instance_outcome outcome;
+    outcome.file = "instance.pol";
+    outcome.status = instance_status::ok;
+    outcome.messages = {"vertices 40", "guards 7 1.5", "iterations 3",
+                        "uncovered 0"};
+    outcome.wall_time = 2;
+    outcome.peak_memory = 0;
+
+    SECTION("a finished run") {
+        auto result = summarize_outcome(outcome);
+        REQUIRE(result.vertices == 40);
+        REQUIRE(result.guards == 7);
+        REQUIRE(result.time == 1.5);
+        REQUIRE(result.iterations == 3);
+        REQUIRE(result.status == "ok");
+    }
+    SECTION("a run stopped by the memory budget") {
+        outcome.messages.push_back("budget");
+        auto result = summarize_outcome(outcome);
+        REQUIRE(result.status == "budget");
+        REQUIRE(result.error == "stopped by the memory budget");
+        REQUIRE(result.guards == 7);
+    }
+    SECTION("guards not covering the gallery") {
+        outcome.messages.back() = "uncovered 2";
+        auto result = summarize_outcome(outcome);
+        REQUIRE(result.status == "uncovered");
+        REQUIRE(result.error == "2 uncovered witnesses");
+    }
+    SECTION("a worker killed by the scheduler") {
+        outcome.status = instance_status::out_of_memory;
+        outcome.messages = {"vertices 40", "budget"};
+        auto result = summarize_outcome(outcome);
+        REQUIRE(result.status == "oom");
+        REQUIRE(result.time == 2);
+    }
+}
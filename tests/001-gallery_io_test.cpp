@@ -0,0 +1,152 @@
+#include <agp/io/gallery_io.h>
+
+#include "test_polygons.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+/// A triangle with coordinates that need fractions, listed clockwise.
+std::vector<Kernel::Point_2> rational_triangle() {
+    Kernel::FT third = Kernel::FT(1) / 3;
+    return {Kernel::Point_2(0, 0),
+            Kernel::Point_2(Kernel::FT(-7) / 2, 5 * third),
+            Kernel::Point_2(third, 2)};
+}
+
+TEST_CASE("Binary galleries are read back unchanged") {
+    const std::string filename = "round_trip_test.agpb";
+    SECTION("integer coordinates") {
+        auto points = orthogonal_comb();
+        // beyond the integers doubles represent exactly
+        Kernel::FT big = Kernel::FT(1 << 30) * (1 << 30) + 1;
+        points[0] = Kernel::Point_2(-big, 0);
+        REQUIRE(narrowest_coordinate_type(points) == coordinate_type::int64);
+        write_gallery_binary(filename, points, coordinate_type::int64);
+        REQUIRE(mapped_gallery(filename).header().coordinates ==
+                coordinate_type::int64);
+        REQUIRE(read_gallery(filename) == points);
+    }
+    SECTION("rational coordinates") {
+        auto points = rational_triangle();
+        REQUIRE(narrowest_coordinate_type(points) ==
+                coordinate_type::rational);
+        write_gallery_binary(filename, points, coordinate_type::rational);
+        REQUIRE(read_gallery(filename) == points);
+    }
+    SECTION("double coordinates are rounded") {
+        auto points = rational_triangle();
+        write_gallery_binary(filename, points, coordinate_type::float64);
+        auto read = read_gallery(filename);
+        REQUIRE(read.size() == points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            REQUIRE(read[i].x() == Kernel::FT(CGAL::to_double(points[i].x())));
+            REQUIRE(read[i].y() == Kernel::FT(CGAL::to_double(points[i].y())));
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Metadata describes the gallery") {
+    const std::string filename = "metadata_test.agpb";
+    SECTION("orthogonal counterclockwise gallery") {
+        write_gallery_binary(filename, orthogonal_comb(),
+                             coordinate_type::int64);
+        mapped_gallery gallery(filename);
+        const auto *m = gallery.metadata();
+        REQUIRE(m != nullptr);
+        REQUIRE(m->min_x == 0);
+        REQUIRE(m->min_y == 0);
+        REQUIRE(m->max_x == 6);
+        REQUIRE(m->max_y == 4);
+        REQUIRE(m->orthogonal == 1);
+        REQUIRE(m->counterclockwise == 1);
+        REQUIRE(m->reflex_count == 4);
+        std::vector<std::uint64_t> reflex(gallery.reflex_vertices(),
+                                          gallery.reflex_vertices() + 4);
+        REQUIRE(reflex == std::vector<std::uint64_t>{4, 5, 8, 9});
+    }
+    SECTION("clockwise triangle") {
+        write_gallery_binary(filename, rational_triangle(),
+                             coordinate_type::rational);
+        mapped_gallery gallery(filename);
+        const auto *m = gallery.metadata();
+        REQUIRE(m != nullptr);
+        REQUIRE(m->min_x == -3.5);
+        REQUIRE(m->max_y == 2);
+        REQUIRE(m->orthogonal == 0);
+        REQUIRE(m->counterclockwise == 0);
+        REQUIRE(m->reflex_count == 0);
+    }
+    SECTION("no metadata") {
+        write_gallery_binary(filename, orthogonal_comb(),
+                             coordinate_type::int64, false);
+        mapped_gallery gallery(filename);
+        REQUIRE(gallery.metadata() == nullptr);
+        REQUIRE(gallery.reflex_vertices() == nullptr);
+        REQUIRE(gallery.points() == orthogonal_comb());
+    }
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Text galleries converted by pol2bin keep their vertices") {
+    const std::string text = "convert_test.pol", binary = "convert_test.agpb";
+    for (const auto &points : {orthogonal_comb(), rational_triangle()}) {
+        {
+            std::ofstream out(text);
+            write_pol(out, points);
+        }
+        // the steps of pol2bin without -double
+        auto read = read_gallery(text);
+        REQUIRE(read == points);
+        write_gallery_binary(binary, read, narrowest_coordinate_type(read));
+        REQUIRE(read_gallery(binary) == points);
+    }
+    std::remove(text.c_str());
+    std::remove(binary.c_str());
+}
+
+/// Writes a binary gallery consisting of the header and the given values.
+void write_raw_gallery(const std::string &filename,
+                       const gallery_header &header,
+                       const std::vector<std::int64_t> &values) {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(values.data()),
+              values.size() * sizeof(std::int64_t));
+}
+
+TEST_CASE("Corrupted binary galleries are rejected") {
+    const std::string filename = "corrupted_gallery_test.agpb";
+    gallery_header header;
+    std::memcpy(header.magic, "AGPB", 4);
+    header.version = 1;
+    header.coordinates = coordinate_type::rational;
+    header.flags = 0;
+    header.vertex_count = 3;
+    header.metadata_offset = 0;
+    std::vector<std::int64_t> values = {0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1};
+
+    SECTION("vertex count overflowing the block size") {
+        header.vertex_count = std::numeric_limits<std::uint64_t>::max() / 16;
+        write_raw_gallery(filename, header, values);
+        REQUIRE_THROWS_AS(mapped_gallery(filename), std::runtime_error);
+    }
+    SECTION("metadata offset past the end of the file") {
+        header.flags = 1;
+        header.metadata_offset = std::numeric_limits<std::uint64_t>::max() - 7;
+        write_raw_gallery(filename, header, values);
+        REQUIRE_THROWS_AS(mapped_gallery(filename), std::runtime_error);
+    }
+    SECTION("zero denominator") {
+        values = {0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1};
+        write_raw_gallery(filename, header, values);
+        mapped_gallery gallery(filename);
+        REQUIRE_THROWS_AS(gallery.points(), std::runtime_error);
+    }
+    std::remove(filename.c_str());
+}
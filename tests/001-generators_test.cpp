@@ -0,0 +1,57 @@
+#include <agp/generators/polygon_generators.h>
+#include <agp/io/gallery_io.h>
+
+#include <CGAL/Polygon_2_algorithms.h>
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+void require_simple_ccw(const std::vector<Kernel::Point_2> &points) {
+    REQUIRE(CGAL::is_simple_2(points.begin(), points.end(), Kernel()));
+    REQUIRE(CGAL::orientation_2(points.begin(), points.end(), Kernel()) ==
+            CGAL::COUNTERCLOCKWISE);
+}
+
+TEST_CASE("Random polygons are simple and deterministic") {
+    for (std::uint64_t seed = 0; seed < 5; ++seed) {
+        auto points = random_polygon(200, seed);
+        REQUIRE(points.size() == 200);
+        require_simple_ccw(points);
+        REQUIRE(points == random_polygon(200, seed));
+    }
+    REQUIRE(random_polygon(50, 1) != random_polygon(50, 2));
+    REQUIRE_THROWS(random_polygon(2));
+}
+
+TEST_CASE("Orthogonal polygons are simple") {
+    auto points = orthogonal_polygon(402, 3);
+    REQUIRE(points.size() == 400);
+    require_simple_ccw(points);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const auto &p = points[i], &q = points[(i + 1) % points.size()];
+        REQUIRE((p.x() == q.x() || p.y() == q.y()));
+    }
+}
+
+TEST_CASE("Von Koch, spiral and comb polygons are simple") {
+    auto koch = von_koch_polygon(2);
+    REQUIRE(koch.size() == 100);
+    require_simple_ccw(koch);
+
+    auto spiral = spiral_polygon(300);
+    REQUIRE(spiral.size() == 300);
+    require_simple_ccw(spiral);
+
+    auto comb = comb_polygon(10);
+    REQUIRE(comb.size() == 32);
+    require_simple_ccw(comb);
+}
+
+TEST_CASE("Generated polygon is read back from the text format") {
+    auto points = random_polygon(30, 4);
+    std::stringstream stream;
+    write_pol(stream, points);
+    std::vector<Kernel::Point_2> read;
+    REQUIRE(read_pol(stream, read));
+    REQUIRE(read == points);
+}
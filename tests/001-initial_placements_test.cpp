@@ -0,0 +1,57 @@
+#include "test_polygons.h"
+
+#include <agp/initial_placements.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+void require_regions(const wg_placement &wg) {
+    REQUIRE(wg.guard_visibility.size() == wg.guards.size());
+    REQUIRE(wg.witness_visibility.size() == wg.witnesses.size());
+    for (std::size_t i = 0; i < wg.guards.size(); ++i)
+        REQUIRE(point_visible(*wg.guard_visibility[i], wg.guards[i]));
+    for (std::size_t i = 0; i < wg.witnesses.size(); ++i)
+        REQUIRE(point_visible(*wg.witness_visibility[i], wg.witnesses[i]));
+}
+
+TEST_CASE("Guards at reflex vertices") {
+    auto wg = reflex_guards(orthogonal_comb());
+    REQUIRE(wg.guards.size() == 4);
+    REQUIRE(wg.witnesses.size() == 8);
+    require_regions(wg);
+}
+
+TEST_CASE("Witnesses in convex components") {
+    auto points = orthogonal_comb();
+    auto wg = convex_witnesses(points);
+    REQUIRE(wg.guards.size() == points.size());
+    REQUIRE_FALSE(wg.witnesses.empty());
+    for (const auto &w : wg.witnesses)
+        REQUIRE(CGAL::bounded_side_2(points.begin(), points.end(), w) ==
+                CGAL::ON_BOUNDED_SIDE);
+    require_regions(wg);
+}
+
+TEST_CASE("Guards at the ends of reflex chords") {
+    auto points = orthogonal_comb();
+    // clockwise input gives the same placement
+    std::reverse(points.begin(), points.end());
+    auto wg = reflex_chords(points);
+    // the chords at the inner reflex vertices end at other reflex vertices,
+    // the six other ends lie on the boundary
+    REQUIRE(wg.guards.size() == 10);
+    REQUIRE(std::find(wg.guards.begin(), wg.guards.end(),
+                      Kernel::Point_2(5, 0)) != wg.guards.end());
+    REQUIRE(std::find(wg.guards.begin(), wg.guards.end(),
+                      Kernel::Point_2(0, 1)) != wg.guards.end());
+    require_regions(wg);
+}
+
+TEST_CASE("Placements by name") {
+    auto points = orthogonal_comb();
+    REQUIRE(placement_by_name("every_second")(points).guards.size() == 6);
+    REQUIRE(placement_by_name("chords")(points).guards.size() == 10);
+    REQUIRE_THROWS_AS(placement_by_name("random"), std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#include <agp/algo/couto_algorithm.h>
+#include <agp/algo/multi_resolution.h>
+#include <agp/arrangement/verification.h>
+#include <agp/discretization_methods.h>
+#include <agp/initial_placements.h>
+
+#include "test_polygons.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+/// The comb with a vertex in the middle of each edge, simplified back to the
+/// comb with tolerance 0.
+std::vector<Kernel::Point_2> detailed_comb() {
+    auto comb = orthogonal_comb();
+    std::vector<Kernel::Point_2> points;
+    for (std::size_t i = 0; i < comb.size(); ++i) {
+        points.push_back(comb[i]);
+        points.push_back(CGAL::midpoint(comb[i], comb[(i + 1) % comb.size()]));
+    }
+    return points;
+}
+
+TEST_CASE("Multi-resolution guards cover the full gallery") {
+    auto points = detailed_comb();
+    multi_resolution_options options;
+    SECTION("Couto's algorithm") {
+        options.vertex_guards = true;
+        auto guards = multi_resolution_algorithm(points, options);
+        REQUIRE(verify_guards(points, guards).empty());
+        // the coarse guards only seed the solve, which stays optimal
+        REQUIRE(guards.size() == couto_algorithm(points, all_vertices).size());
+        for (const auto &g : guards)
+            REQUIRE(std::find(points.begin(), points.end(), g) !=
+                    points.end());
+    }
+    SECTION("Baumgartner's algorithm") {
+        options.vertex_guards = false;
+        options.sec = 60;
+        auto guards = multi_resolution_algorithm(points, options);
+        REQUIRE(!guards.empty());
+        REQUIRE(verify_guards(points, guards).empty());
+    }
+}
+
+TEST_CASE("Both solves are reported as one run") {
+    auto points = detailed_comb();
+    std::vector<iteration_progress> states;
+    multi_resolution_options options;
+    options.progress = [&states](const iteration_progress &state) {
+        states.push_back(state);
+        return true;
+    };
+    auto guards = multi_resolution_algorithm(points, options);
+
+    REQUIRE(states.size() >= 2);
+    // the coarse solve reports no solution of the full gallery
+    REQUIRE(states.front().incumbent.empty());
+    REQUIRE(states.front().lower_bound == 0);
+    for (std::size_t k = 1; k < states.size(); ++k) {
+        REQUIRE(states[k].iteration > states[k - 1].iteration);
+        REQUIRE(states[k].elapsed >= states[k - 1].elapsed);
+    }
+    for (const auto &state : states)
+        REQUIRE(state.lower_bound <= guards.size());
+}
+
+TEST_CASE("Stopping the coarse solve stops the full one") {
+    auto points = detailed_comb();
+    std::size_t calls = 0;
+    multi_resolution_options options;
+    options.progress = [&calls](const iteration_progress &) {
+        ++calls;
+        return false;
+    };
+    auto guards = multi_resolution_algorithm(points, options);
+    // one iteration of each solve, Couto's algorithm returns no guards if
+    // they don't cover the gallery yet
+    REQUIRE(calls == 2);
+    REQUIRE((guards.empty() || verify_guards(points, guards).empty()));
+}
+
+TEST_CASE("Guards of the coarse gallery become candidates") {
+    auto points = orthogonal_comb();
+    std::vector<Kernel::Point_2> extra = {
+        Kernel::Point_2(3, 2), Kernel::Point_2(0, 0), Kernel::Point_2(9, 9)};
+    auto plain = every_second(points);
+    auto wg = with_guards(every_second, extra)(points);
+
+    // the inner point is added, the known vertex and the outer point aren't
+    REQUIRE(wg.guards.size() == plain.guards.size() + 1);
+    REQUIRE(wg.guard_visibility.size() == wg.guards.size());
+    REQUIRE(std::count(wg.guards.begin(), wg.guards.end(), extra[0]) == 1);
+    REQUIRE(std::count(wg.guards.begin(), wg.guards.end(), extra[1]) == 1);
+    REQUIRE(std::find(wg.guards.begin(), wg.guards.end(), extra[2]) ==
+            wg.guards.end());
+    REQUIRE(wg.witnesses == plain.witnesses);
+}
+
+TEST_CASE("Couto's IPs start from a given solution") {
+    auto points = orthogonal_comb();
+    auto optimum = couto_algorithm(points, all_vertices);
+    // a poor start, every vertex, and the optimum itself
+    for (const auto &start : {points, optimum}) {
+        auto guards = couto_algorithm(points, all_vertices, 0, nullptr,
+                                      nullptr, nullptr, start);
+        REQUIRE(guards.size() == optimum.size());
+        REQUIRE(verify_guards(points, guards).empty());
+    }
+}
@@ -0,0 +1,41 @@
+#include "test_polygons.h"
+
+#include <agp/arrangement/orthogonal.h>
+#include <agp/arrangement/visibility.h>
+#include <agp/discretization_methods.h>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Detect orthogonal polygons") {
+    REQUIRE(is_orthogonal(orthogonal_comb()));
+    REQUIRE(guard_upper_bound(orthogonal_comb()) == 3);
+    std::vector<Kernel::Point_2> triangle = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(0, 4)};
+    REQUIRE_FALSE(is_orthogonal(triangle));
+    REQUIRE(guard_upper_bound(triangle) == 1);
+}
+
+TEST_CASE("Grid cells lie inside the polygon") {
+    auto points = orthogonal_comb();
+    auto cells = orthogonal_cells(points);
+    REQUIRE(cells.size() == 8);
+    // the two cells above the notches are outside
+    REQUIRE(grid_cell_bound(points) == 10);
+    for (const auto &cell : cells) {
+        auto center = CGAL::midpoint(cell.lower_left, cell.upper_right);
+        REQUIRE(CGAL::bounded_side_2(points.begin(), points.end(), center) ==
+                CGAL::ON_BOUNDED_SIDE);
+    }
+    REQUIRE(orthogonal_grid(points).size() == cells.size());
+}
+
+TEST_CASE("Cells seen by single guards") {
+    auto points = orthogonal_comb();
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto regions = all_visibility_regions(polygon, points);
+    auto cells = orthogonal_cells(points);
+    // the bottom corners see the bottom row and the outer teeth, the middle
+    // tooth is seen from its top corners
+    REQUIRE(cells_seen(cells, regions, {0, 1, 6}));
+    REQUIRE_FALSE(cells_seen(cells, regions, {0, 1}));
+}
@@ -0,0 +1,46 @@
+#include <agp/algo/portfolio.h>
+#include <agp/arrangement/verification.h>
+#include <agp/generators/polygon_generators.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+
+TEST_CASE("Portfolio proves its vertex guard solution optimal") {
+    auto points = comb_polygon(3);
+    portfolio_options options;
+    options.vertex_guards = true;
+    auto result = portfolio_algorithm(points, options);
+
+    REQUIRE(result.guards.size() >= 3);
+    REQUIRE(verify_guards(points, result.guards).empty());
+    REQUIRE((result.algorithm == "fisk" || result.algorithm == "ghosh" ||
+             result.algorithm == "couto"));
+    REQUIRE(result.optimal);
+    REQUIRE(result.lower_bound == result.guards.size());
+}
+
+TEST_CASE("Portfolio reports the bounds of its point guard solution") {
+    auto points = comb_polygon(2);
+    auto result = portfolio_algorithm(points);
+
+    REQUIRE(!result.guards.empty());
+    REQUIRE(verify_guards(points, result.guards).empty());
+    REQUIRE(!result.algorithm.empty());
+    REQUIRE(result.lower_bound <= result.guards.size());
+    REQUIRE(result.optimal == (result.lower_bound == result.guards.size()));
+}
+
+TEST_CASE("Portfolio stops at its time limit") {
+    portfolio_options options;
+    options.time_limit = 1e-9;
+    auto begin = std::chrono::steady_clock::now();
+    auto result = portfolio_algorithm(comb_polygon(30), options);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+
+    // the limit passes before any algorithm starts
+    REQUIRE(result.guards.empty());
+    REQUIRE(!result.optimal);
+    REQUIRE(elapsed.count() < 5);
+}
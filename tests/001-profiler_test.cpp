@@ -0,0 +1,74 @@
+#include <agp/arrangement/compaction.h>
+#include <agp/profile/profiler.h>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+TEST_CASE("Disabled profiler records nothing") {
+    set_profiling(false);
+    reset_profile();
+    {
+        AGP_PROFILE_SCOPE("phase");
+        AGP_PROFILE_COUNT("iterations", 1);
+        AGP_PROFILE_MAX("size", 1);
+    }
+    std::ostringstream summary;
+    write_profile_json(summary);
+    REQUIRE(summary.str().find("{\"timers\":{},\"counters\":{},"
+                               "\"maximums\":{},") == 0);
+}
+
+TEST_CASE("Enabled profiler records timers and counters") {
+    set_profiling(true);
+    reset_profile();
+    for (int i = 0; i < 3; ++i) {
+        AGP_PROFILE_SCOPE("phase");
+        AGP_PROFILE_COUNT("iterations", 2);
+        AGP_PROFILE_MAX("size", 5 - i);
+    }
+    set_profiling(false);
+
+    std::ostringstream summary, trace;
+    write_profile_json(summary);
+    write_chrome_trace(trace);
+    REQUIRE(summary.str().find("\"phase\":{\"calls\":3") !=
+            std::string::npos);
+    REQUIRE(summary.str().find("\"iterations\":6") != std::string::npos);
+    REQUIRE(summary.str().find("\"size\":5") != std::string::npos);
+    REQUIRE(trace.str().find("\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(trace.str().find("\"ph\":\"C\"") != std::string::npos);
+    reset_profile();
+}
+
+TEST_CASE("The heap is measured only if asked for") {
+    set_profiling(true);
+    for (bool heap : {false, true}) {
+        set_heap_profiling(heap);
+        reset_profile();
+        { AGP_PROFILE_SCOPE("phase"); }
+        std::ostringstream trace;
+        write_chrome_trace(trace);
+        REQUIRE((trace.str().find("\"heap\"") != std::string::npos) == heap);
+    }
+    set_heap_profiling(false);
+    set_profiling(false);
+    reset_profile();
+}
+
+TEST_CASE("Only exact values computed by compaction are counted") {
+    Kernel::Point_2 p = CGAL::midpoint(Kernel::Point_2(0, 0),
+                                       Kernel::Point_2(1, 3));
+    set_profiling(true);
+    reset_profile();
+    exactify(p);
+    exactify(p);
+    set_profiling(false);
+
+    std::ostringstream summary;
+    write_profile_json(summary);
+    REQUIRE(summary.str().find("\"exactify_calls\":2") != std::string::npos);
+    REQUIRE(summary.str().find("\"exact_evaluations\":1") !=
+            std::string::npos);
+    reset_profile();
+}
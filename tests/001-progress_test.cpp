@@ -0,0 +1,77 @@
+#include <agp/algo/baumgartner_algorithm.h>
+#include <agp/algo/couto_algorithm.h>
+#include <agp/algo/progress.h>
+#include <agp/discretization_methods.h>
+#include <agp/initial_placements.h>
+
+#include "test_polygons.h"
+
+#include <catch2/catch.hpp>
+
+#include <climits>
+
+/// Callback recording every reported state.
+progress_callback record(std::vector<iteration_progress> &states) {
+    return [&states](const iteration_progress &state) {
+        states.push_back(state);
+        return true;
+    };
+}
+
+TEST_CASE("Reported bounds enclose the solution") {
+    auto points = orthogonal_comb();
+    std::vector<iteration_progress> states;
+    std::vector<Kernel::Point_2> guards;
+    SECTION("Couto's algorithm") {
+        guards = couto_algorithm(points, all_vertices, 0, nullptr, nullptr,
+                                 record(states));
+    }
+    SECTION("Baumgartner's algorithm") {
+        guards = baumgartner_algorithm(points, every_second, INT_MAX, 0,
+                                       nullptr, nullptr, record(states));
+    }
+    REQUIRE(!guards.empty());
+    REQUIRE(!states.empty());
+    for (const auto &state : states) {
+        // the bounds are proven, so no solution beats the lower one
+        REQUIRE(state.lower_bound <= guards.size());
+        REQUIRE(state.upper_bound >= state.lower_bound);
+        if (!state.incumbent.empty())
+            REQUIRE(state.incumbent.size() <= state.upper_bound);
+    }
+}
+
+TEST_CASE("A tiny memory budget stops after the first iteration") {
+    auto points = orthogonal_comb();
+    bool exceeded = false, called = false;
+    std::vector<iteration_progress> states;
+    auto budget = memory_budget(1, record(states), &exceeded);
+    unsigned long iterations = 0;
+    auto progress = [&](const iteration_progress &state) {
+        iterations = state.iteration;
+        called = true;
+        return budget(state);
+    };
+    SECTION("Couto's algorithm") {
+        couto_algorithm(points, all_vertices, 0, nullptr, nullptr, progress);
+    }
+    SECTION("Baumgartner's algorithm") {
+        baumgartner_algorithm(points, every_second, INT_MAX, 0, nullptr,
+                              nullptr, progress);
+    }
+    REQUIRE(called);
+    REQUIRE(iterations == 1);
+    REQUIRE(exceeded);
+    // the wrapped callback is not called once the budget is exceeded
+    REQUIRE(states.empty());
+}
+
+TEST_CASE("A memory budget that is not exceeded passes the states on") {
+    bool exceeded = false;
+    std::vector<iteration_progress> states;
+    auto budget = memory_budget(std::size_t(-1), record(states), &exceeded);
+    REQUIRE(budget(iteration_progress()));
+    REQUIRE(states.size() == 1);
+    REQUIRE(!exceeded);
+    REQUIRE(memory_budget(std::size_t(-1))(iteration_progress()));
+}
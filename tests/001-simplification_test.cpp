@@ -0,0 +1,62 @@
+#include <agp/arrangement/simplification.h>
+
+#include <CGAL/Polygon_2_algorithms.h>
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+TEST_CASE("Collinear vertices are merged") {
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(1, 0), Kernel::Point_2(2, 0),
+        Kernel::Point_2(2, 1), Kernel::Point_2(2, 2), Kernel::Point_2(0, 2)};
+    auto simplified = simplify_polygon(points, 0);
+    std::vector<Kernel::Point_2> square = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(2, 0), Kernel::Point_2(2, 2),
+        Kernel::Point_2(0, 2)};
+    REQUIRE(simplified == square);
+}
+
+TEST_CASE("Vertices within the tolerance are merged") {
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0),
+        Kernel::Point_2(4, 4), Kernel::Point_2(2, Kernel::FT(41) / 10),
+        Kernel::Point_2(0, 4)};
+    REQUIRE(simplify_polygon(points, 0).size() == 5);
+    REQUIRE(simplify_polygon(points, Kernel::FT(1) / 5).size() == 4);
+}
+
+TEST_CASE("Simplified polygons stay simple") {
+    // a narrow slit would be closed by merging the vertices at its bottom
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(0, 0),  Kernel::Point_2(4, 0),
+        Kernel::Point_2(4, 4),  Kernel::Point_2(3, 4),
+        Kernel::Point_2(3, 1),  Kernel::Point_2(1, 1),
+        Kernel::Point_2(1, 4),  Kernel::Point_2(0, 4)};
+    auto simplified = simplify_polygon(points, 10);
+    REQUIRE(simplified.size() >= 3);
+    REQUIRE(CGAL::is_simple_2(simplified.begin(), simplified.end()));
+    // vertices of the simplified polygon are vertices of the original one
+    for (const auto &p : simplified)
+        REQUIRE(std::find(points.begin(), points.end(), p) != points.end());
+}
+
+TEST_CASE("Every removed vertex stays within the tolerance") {
+    // each vertex of the flat arc is close to the chord of its neighbours,
+    // merging them one by one would drift away from the arc
+    std::vector<Kernel::Point_2> points = {Kernel::Point_2(0, -5),
+                                           Kernel::Point_2(10, -5)};
+    for (int k = 10; k >= 0; --k)
+        points.emplace_back(k, Kernel::FT(k * (10 - k)) / 10);
+    Kernel::FT tolerance = Kernel::FT(3) / 10;
+    auto simplified = simplify_polygon(points, tolerance);
+    REQUIRE(simplified.size() < points.size());
+    for (const auto &p : points) {
+        bool close = false;
+        for (std::size_t i = 0; i < simplified.size() && !close; ++i) {
+            Kernel::Segment_2 edge(simplified[i],
+                                   simplified[(i + 1) % simplified.size()]);
+            close = CGAL::squared_distance(p, edge) <= tolerance * tolerance;
+        }
+        REQUIRE(close);
+    }
+}
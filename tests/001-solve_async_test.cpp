@@ -0,0 +1,53 @@
+#include <agp/algo/solve_async.h>
+#include <agp/arrangement/verification.h>
+#include <agp/generators/polygon_generators.h>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+TEST_CASE("Handle without a job is invalid") {
+    solve_handle handle;
+    REQUIRE(!handle.valid());
+    REQUIRE(!handle.ready());
+    handle.cancel();
+    REQUIRE(!handle.cancelled());
+    REQUIRE(handle.progress().iteration == 0);
+    REQUIRE(handle.partial_result().empty());
+    REQUIRE_THROWS_AS(handle.get(), std::logic_error);
+}
+
+TEST_CASE("Job returns guards covering the gallery") {
+    auto points = comb_polygon(3);
+    for (auto algorithm : {agp_algorithm::fisk, agp_algorithm::couto}) {
+        auto handle = solve_async(points, algorithm);
+        REQUIRE(handle.valid());
+        auto guards = handle.get();
+        REQUIRE(!handle.valid());
+        REQUIRE(!guards.empty());
+        REQUIRE(verify_guards(points, guards).empty());
+    }
+}
+
+TEST_CASE("Partial result is the incumbent of the last iteration") {
+    auto points = comb_polygon(3);
+    auto handle = solve_async(points, agp_algorithm::baumgartner);
+    auto guards = handle.get();
+    REQUIRE(handle.progress().iteration > 0);
+    REQUIRE(handle.partial_result() == guards);
+
+    // Couto's incumbent exists only after the last iteration
+    auto couto = solve_async(points, agp_algorithm::couto);
+    guards = couto.get();
+    REQUIRE(couto.partial_result() == guards);
+}
+
+TEST_CASE("Cancelled job stops after at most one iteration") {
+    auto points = comb_polygon(30);
+    auto handle = solve_async(points, agp_algorithm::baumgartner);
+    handle.cancel();
+    REQUIRE(handle.cancelled());
+    auto guards = handle.get();
+    REQUIRE(handle.progress().iteration <= 1);
+    REQUIRE((guards.empty() || verify_guards(points, guards).empty()));
+}
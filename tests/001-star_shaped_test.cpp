@@ -0,0 +1,71 @@
+#include "test_polygons.h"
+
+#include <agp/arrangement/star_shaped.h>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Kernel of a convex polygon is the polygon") {
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(4, 4),
+        Kernel::Point_2(0, 4)};
+    REQUIRE(polygon_kernel(points) == points);
+    Kernel::Point_2 guard;
+    REQUIRE(star_shaped_guard(points, true, guard));
+    REQUIRE(guard == points[0]);
+}
+
+TEST_CASE("Kernel of an L-shaped polygon in both orientations") {
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(4, 0), Kernel::Point_2(4, 2),
+        Kernel::Point_2(2, 2), Kernel::Point_2(2, 4), Kernel::Point_2(0, 4)};
+    auto kernel = polygon_kernel(points);
+    REQUIRE(kernel.size() == 4);
+    REQUIRE(std::find(kernel.begin(), kernel.end(), Kernel::Point_2(2, 2)) !=
+            kernel.end());
+    std::vector<Kernel::Point_2> reversed(points.rbegin(), points.rend());
+    REQUIRE(polygon_kernel(reversed).size() == 4);
+    Kernel::Point_2 guard;
+    REQUIRE(star_shaped_guard(reversed, true, guard));
+}
+
+TEST_CASE("Comb is not star-shaped") {
+    auto points = orthogonal_comb();
+    REQUIRE(polygon_kernel(points).empty());
+    Kernel::Point_2 guard;
+    REQUIRE_FALSE(star_shaped_guard(points, false, guard));
+}
+
+TEST_CASE("Kernel of a pinwheel contains no vertex") {
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(1, 0),  Kernel::Point_2(3, 1),
+        Kernel::Point_2(0, 1),  Kernel::Point_2(-1, 3),
+        Kernel::Point_2(-1, 0), Kernel::Point_2(-3, -1),
+        Kernel::Point_2(0, -1), Kernel::Point_2(1, -3)};
+    REQUIRE(polygon_kernel(points).size() == 4);
+    Kernel::Point_2 guard;
+    REQUIRE_FALSE(star_shaped_guard(points, true, guard));
+    REQUIRE(star_shaped_guard(points, false, guard));
+    REQUIRE(guard == Kernel::Point_2(0, 0));
+
+    std::vector<Kernel::Point_2> guards;
+    std::vector<Arrangement_2> regions;
+    REQUIRE(star_shaped_solution(points, false, guards, &regions));
+    REQUIRE(guards.size() == 1);
+    REQUIRE(regions.size() == 1);
+    REQUIRE(regions[0].number_of_vertices() == points.size());
+}
+
+TEST_CASE("Kernel of two blocks meeting along a line is a segment") {
+    // the lower and the upper block overlap along y = 1, their edges on it
+    // face opposite sides
+    std::vector<Kernel::Point_2> points = {
+        Kernel::Point_2(0, -3), Kernel::Point_2(6, -3), Kernel::Point_2(6, 1),
+        Kernel::Point_2(4, 1),  Kernel::Point_2(4, 3),  Kernel::Point_2(-2, 3),
+        Kernel::Point_2(-2, 1), Kernel::Point_2(0, 1)};
+    auto kernel = polygon_kernel(points);
+    REQUIRE(kernel == std::vector<Kernel::Point_2>{Kernel::Point_2(0, 1),
+                                                   Kernel::Point_2(4, 1)});
+    Kernel::Point_2 guard;
+    REQUIRE(star_shaped_guard(points, true, guard));
+    REQUIRE(guard.y() == 1);
+}
@@ -0,0 +1,110 @@
+#include <agp/parallel/thread_pool.h>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+TEST_CASE("Pool runs submitted tasks") {
+    thread_pool pool(3);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i)
+        futures.push_back(pool.submit([i] { return i * i; }));
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(pool.wait(futures[i]) == i * i);
+}
+
+TEST_CASE("Tasks can wait for nested tasks") {
+    thread_pool pool(2);
+    std::function<long(int)> sum = [&](int n) -> long {
+        if (n <= 1)
+            return n;
+        auto left = pool.submit([&sum, n] { return sum(n / 2); });
+        long right = sum(n - n / 2);
+        return pool.wait(left) + right;
+    };
+    auto total = pool.submit([&sum] { return sum(1000); });
+    REQUIRE(pool.wait(total) == 1000);
+}
+
+TEST_CASE("Waiting threads run only tasks they submitted") {
+    thread_pool pool(1);
+    std::atomic<bool> started(false), finish(false);
+    auto blocker = pool.submit([&] {
+        started = true;
+        while (!finish)
+            std::this_thread::yield();
+    });
+    while (!started)
+        std::this_thread::yield();
+
+    // a job of another thread stays queued while the only worker is busy
+    std::future<int> job;
+    std::thread([&] { job = pool.submit([] { return 1; }); }).join();
+    REQUIRE(!pool.run_pending_task());
+
+    auto own = pool.submit([] { return 2; });
+    REQUIRE(pool.run_pending_task());
+    REQUIRE(own.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready);
+    REQUIRE(job.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready);
+
+    finish = true;
+    pool.wait(blocker);
+    REQUIRE(job.get() == 1);
+}
+
+TEST_CASE("Exceptions are passed to the waiting thread") {
+    thread_pool pool(1);
+    auto future = pool.submit([]() -> int { throw std::runtime_error("x"); });
+    REQUIRE_THROWS_AS(pool.wait(future), std::runtime_error);
+}
+
+TEST_CASE("Captured objects are released before the result is ready") {
+    thread_pool pool(2);
+    auto shared = std::make_shared<int>(1);
+    auto future = pool.submit([shared] { return *shared; });
+    REQUIRE(pool.wait(future) == 1);
+    REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("Reserved workers are returned to the pool") {
+    thread_pool pool(2);
+    REQUIRE(pool.reserve(5) == 2);
+    REQUIRE(pool.reserve(1) == 0);
+    auto future = pool.submit([] { return 1; });
+    REQUIRE(pool.wait(future) == 1);
+    pool.release(2);
+    REQUIRE(pool.reserve(1) == 1);
+    pool.release(1);
+}
+
+TEST_CASE("Workers running a task are not reserved") {
+    thread_pool pool(2);
+    std::atomic<bool> started(false), finish(false);
+    auto future = pool.submit([&] {
+        started = true;
+        while (!finish)
+            std::this_thread::yield();
+    });
+    while (!started)
+        std::this_thread::yield();
+    REQUIRE(pool.reserve(2) == 1);
+    finish = true;
+    pool.wait(future);
+    pool.release(1);
+}
+
+TEST_CASE("Parallel for visits every index once") {
+    for (unsigned threads : {1u, 4u}) {
+        set_thread_count(threads);
+        REQUIRE(thread_count() == threads);
+        std::vector<std::atomic<int>> visits(1000);
+        parallel_for(0, visits.size(), [&](std::size_t i) { ++visits[i]; });
+        for (auto &v : visits)
+            REQUIRE(v == 1);
+    }
+    set_thread_count(0);
+}
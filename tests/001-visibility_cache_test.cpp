@@ -0,0 +1,119 @@
+#include <agp/io/visibility_cache.h>
+
+#include "test_polygons.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+/// Sorted vertices of the bounded face of a region, equal for regions built
+/// from the same boundary starting at different vertices.
+std::vector<Kernel::Point_2> sorted_boundary(const Arrangement_2 &region) {
+    auto f = region.faces_begin();
+    while (f->is_unbounded())
+        ++f;
+    auto vertices = face_vertices(f);
+    std::sort(vertices.begin(), vertices.end());
+    return vertices;
+}
+
+void require_same_regions(const std::vector<Arrangement_2> &a,
+                          const std::vector<Arrangement_2> &b) {
+    REQUIRE(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+        REQUIRE(sorted_boundary(a[i]) == sorted_boundary(b[i]));
+}
+
+/// Writes points in the format of the cache, a count and exact coordinates.
+void write_cached_points(std::ostream &out,
+                         const std::vector<Kernel::Point_2> &points) {
+    out << points.size() << "\n";
+    for (const auto &p : points)
+        out << CGAL::exact(p.x()) << " " << CGAL::exact(p.y()) << "\n";
+}
+
+/// Writes a cache file for the vertices with the same region for every
+/// vertex, a triangle unlike any region of the comb.
+void write_triangle_cache(const std::string &filename,
+                          const std::vector<Kernel::Point_2> &vertices) {
+    std::vector<Kernel::Point_2> triangle = {
+        Kernel::Point_2(0, 0), Kernel::Point_2(1, 0), Kernel::Point_2(0, 1)};
+    std::ofstream out(filename);
+    out << "AGPVIS 1\n";
+    write_cached_points(out, vertices);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+        write_cached_points(out, triangle);
+}
+
+std::string file_contents(const std::string &filename) {
+    std::ifstream in(filename);
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+TEST_CASE("Visibility cache") {
+    char directory[] = "visibility_cache_test_XXXXXX";
+    REQUIRE(mkdtemp(directory) != nullptr);
+    set_visibility_cache_directory(directory);
+
+    auto points = orthogonal_comb();
+    auto polygon = create_arrangement<Arrangement_2>(points);
+    auto computed = all_visibility_regions(polygon, points);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.vis",
+                  static_cast<unsigned long long>(polygon_hash(points)));
+    std::string filename = std::string(directory) + "/" + name;
+
+    SECTION("a miss stores the regions and a hit reads them") {
+        REQUIRE(access(filename.c_str(), R_OK) != 0);
+        require_same_regions(cached_visibility_regions(polygon, points),
+                             computed);
+        REQUIRE(access(filename.c_str(), R_OK) == 0);
+        require_same_regions(cached_visibility_regions(polygon, points),
+                             computed);
+
+        // regions of a hit come from the file, not from a new computation
+        write_triangle_cache(filename, points);
+        auto read = cached_visibility_regions(polygon, points);
+        REQUIRE(read.size() == points.size());
+        REQUIRE(sorted_boundary(read[0]).size() == 3);
+    }
+    SECTION("a file of another gallery with the same hash is recomputed") {
+        auto other = points;
+        other.back() = Kernel::Point_2(0, 5);
+        write_triangle_cache(filename, other);
+        std::string collision = file_contents(filename);
+        require_same_regions(cached_visibility_regions(polygon, points),
+                             computed);
+        // the entry now holds the regions of the gallery
+        REQUIRE(file_contents(filename) != collision);
+        require_same_regions(cached_visibility_regions(polygon, points),
+                             computed);
+    }
+    SECTION("a truncated or corrupted file is recomputed") {
+        cached_visibility_regions(polygon, points);
+        std::string contents = file_contents(filename);
+        for (const auto &broken :
+             {contents.substr(0, contents.size() / 2),
+              std::string("AGPVIS 1\n12\ngarbage\n"), std::string()}) {
+            {
+                std::ofstream out(filename, std::ios::trunc);
+                out << broken;
+            }
+            require_same_regions(cached_visibility_regions(polygon, points),
+                                 computed);
+            REQUIRE(file_contents(filename) == contents);
+        }
+    }
+
+    std::remove(filename.c_str());
+    rmdir(directory);
+    set_visibility_cache_directory("");
+}
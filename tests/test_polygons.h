@@ -0,0 +1,23 @@
+/*! \file test_polygons.h
+ * \brief Small galleries shared by the tests.
+ */
+#ifndef AGP_TESTS_TEST_POLYGONS_H
+#define AGP_TESTS_TEST_POLYGONS_H
+
+#include <agp/arrangement/utils.h>
+
+#include <vector>
+
+/// Orthogonal comb with three teeth of width 1, 2 and 1 between two notches,
+/// counterclockwise from the bottom left corner. Its reflex vertices are 4,
+/// 5, 8 and 9.
+inline std::vector<Kernel::Point_2> orthogonal_comb() {
+    return {Kernel::Point_2(0, 0), Kernel::Point_2(6, 0),
+            Kernel::Point_2(6, 4), Kernel::Point_2(5, 4),
+            Kernel::Point_2(5, 1), Kernel::Point_2(4, 1),
+            Kernel::Point_2(4, 4), Kernel::Point_2(2, 4),
+            Kernel::Point_2(2, 1), Kernel::Point_2(1, 1),
+            Kernel::Point_2(1, 4), Kernel::Point_2(0, 4)};
+}
+
+#endif // AGP_TESTS_TEST_POLYGONS_H